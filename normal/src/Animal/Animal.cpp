@@ -6,43 +6,52 @@
 #include "../Random/Uniform.hpp"
 #include "Scorpion.hpp"
 #include "Gerbil.hpp"
+#include "SpeciesAnimal.hpp"
+#include "SteeringBatch.hpp"
 
 Animal::Animal(const Vec2d& position,const double& size, const double& energy, const bool& isFemale) :
     OrganicEntity( position, size, energy),
     direction_(1,0),
-    speed_(0),
     current_target_(1,0),
-    is_female_(isFemale),
+    speed_(0),
     energy_consumption_factor_(0),
-    time_pause_feeding_(sf::seconds(getAppConfig().animal_feed_time)),
-    state_(WANDERING),
+    view_cos_range_(-1),
+    view_cos_half_angle_(1),
     target_entity_(nullptr),
-    pregnant_(false),
-    babies_(0),
-    birth_pause_timer_(sf::seconds(getAppConfig().animal_delivery_time)),
-    time_pause_mating_(sf::seconds(getAppConfig().animal_mating_time)),
+    organic_entity_mum_(nullptr),
     time_gestation_limit_(sf::seconds(10)),
-    time_gestation_(sf::Time::Zero) ,
-    time_running_away_(sf::seconds(getAppConfig().animal_running_away)),
-    organic_entity_mum_(nullptr)
+    perception_due_(sf::Time::Zero),
+    state_timer_(TimerWheel::NONE),
+    gestation_timer_(TimerWheel::NONE),
+    babies_(0),
+    state_(WANDERING),
+    timed_state_(WANDERING),
+    is_female_(isFemale),
+    pregnant_(false),
+    perception_stale_(true)
 { } 
 
 Animal::Animal(const Vec2d& position,const double& size, const double& energy, const bool& isFemale, const sf::Time& ageLimit, const double& energyConsumptionFactor,
                const double&  gestationLimit ) :
-    OrganicEntity( position, size, energy, ageLimit), direction_(1,0), speed_(0), current_target_(1,0),
-    is_female_(isFemale),
+    OrganicEntity( position, size, energy, ageLimit),
+    direction_(1,0),
+    current_target_(1,0),
+    speed_(0),
     energy_consumption_factor_(energyConsumptionFactor),
-    time_pause_feeding_(sf::seconds(getAppConfig().animal_feed_time)),
-    state_(WANDERING),
+    view_cos_range_(-1),
+    view_cos_half_angle_(1),
     target_entity_(nullptr),
-    pregnant_(false),
-    babies_(0),
-    birth_pause_timer_(sf::seconds(getAppConfig().animal_delivery_time)),
-    time_pause_mating_(sf::seconds(getAppConfig().animal_mating_time)),
+    organic_entity_mum_(nullptr),
     time_gestation_limit_(sf::seconds(gestationLimit)),
-    time_gestation_(sf::Time::Zero) ,
-    time_running_away_(sf::seconds(getAppConfig().animal_running_away)),
-    organic_entity_mum_(nullptr)
+    perception_due_(sf::Time::Zero),
+    state_timer_(TimerWheel::NONE),
+    gestation_timer_(TimerWheel::NONE),
+    babies_(0),
+    state_(WANDERING),
+    timed_state_(WANDERING),
+    is_female_(isFemale),
+    pregnant_(false),
+    perception_stale_(true)
 { }
 
 Animal::Animal(const Vec2d& position,const double& size, const double& energy, const bool& isFemale, const sf::Time& ageLimit, const double& energyConsumptionFactor, const double&  gestationLimit, const Vec2d& direction) :
@@ -50,40 +59,47 @@ Animal::Animal(const Vec2d& position,const double& size, const double& energy, c
 { }
 
 Animal::Animal(const Vec2d& position,const double& size, const double& energy, const bool& isFemale, const sf::Time& ageLimit, const double& energyConsumptionFactor, const double&  gestationLimit, const Vec2d& direction, OrganicEntity* mum) :
-    OrganicEntity( position, size/ANIMAL_BABY_SIZE_FACTOR, energy, ageLimit), direction_(direction), speed_(0), current_target_(1,0),
-    is_female_(isFemale),
+    OrganicEntity( position, size/ANIMAL_BABY_SIZE_FACTOR, energy, ageLimit),
+    direction_(direction),
+    current_target_(1,0),
+    speed_(0),
     energy_consumption_factor_(energyConsumptionFactor),
-    time_pause_feeding_(sf::seconds(getAppConfig().animal_feed_time)),
-    state_(BABY),
+    view_cos_range_(-1),
+    view_cos_half_angle_(1),
     target_entity_(nullptr),
-    pregnant_(false),
-    babies_(0),
-    birth_pause_timer_(sf::seconds(getAppConfig().animal_delivery_time)),
-    time_pause_mating_(sf::seconds(getAppConfig().animal_mating_time)),
+    organic_entity_mum_(mum),
     time_gestation_limit_(sf::seconds(gestationLimit)),
-    time_gestation_(sf::Time::Zero) ,
-    time_running_away_(sf::seconds(getAppConfig().animal_running_away)),
-    organic_entity_mum_(mum)
+    perception_due_(sf::Time::Zero),
+    state_timer_(TimerWheel::NONE),
+    gestation_timer_(TimerWheel::NONE),
+    babies_(0),
+    state_(BABY),
+    timed_state_(WANDERING),
+    is_female_(isFemale),
+    pregnant_(false),
+    perception_stale_(true)
 { }
 
 Animal::Animal(const Vec2d& position,const double& size, const double& energy, const bool& isFemale, const sf::Time& ageLimit) :
     OrganicEntity( position, size, energy, ageLimit),
     direction_(1,0),
-    speed_(0),
     current_target_(1,0),
-    is_female_(isFemale),
+    speed_(0),
     energy_consumption_factor_(0),
-    time_pause_feeding_(sf::seconds(getAppConfig().animal_feed_time)),
-    state_(WANDERING),
+    view_cos_range_(-1),
+    view_cos_half_angle_(1),
     target_entity_(nullptr),
-    pregnant_(false),
-    babies_(0),
-    birth_pause_timer_(sf::seconds(getAppConfig().animal_delivery_time)),
-    time_pause_mating_(sf::seconds(getAppConfig().animal_mating_time)),
+    organic_entity_mum_(nullptr),
     time_gestation_limit_(sf::seconds(10)),
-    time_gestation_(sf::Time::Zero),
-    time_running_away_(sf::seconds(getAppConfig().animal_running_away)),
-    organic_entity_mum_(nullptr)
+    perception_due_(sf::Time::Zero),
+    state_timer_(TimerWheel::NONE),
+    gestation_timer_(TimerWheel::NONE),
+    babies_(0),
+    state_(WANDERING),
+    timed_state_(WANDERING),
+    is_female_(isFemale),
+    pregnant_(false),
+    perception_stale_(true)
 { } 
 
 Vec2d Animal::getSpeedVector() const
@@ -91,23 +107,30 @@ Vec2d Animal::getSpeedVector() const
     return direction_*speed_;
 } 
 
-void Animal::giveBirth()
+void Animal::giveBirth(Environment& env)
 {
-    return this->giveBirthThis();
+    return this->giveBirthThis(env);
 }
 
-void Animal::meet(OrganicEntity* O)
+void Animal::meet(Environment& env, OrganicEntity* O)
 {
-    state_= MATING;
-    return O->meetThis(this);
+    enterTimedState(env, MATING, sf::seconds(getAppConfig().animal_mating_time));
+    if (!env.isDeferring()) {
+        return O->meetThis(env, this);
+    }
+    // the partner may have mated on another tile in the meantime
+    env.defer([this, &env, O] {
+        if (matable(O) and O->matable(this)) O->meetThis(env, this);
+    });
 }
 
-void Animal::meetThis(Animal* A) 
+void Animal::meetThis(Environment& env, Animal* A) 
 {
-    state_= MATING;
+    enterTimedState(env, MATING, sf::seconds(getAppConfig().animal_mating_time));
     int babies(uniform(getAppConfig().gerbil_min_children,getAppConfig().gerbil_max_children));
     if(isFemale()) {
         setPregnant(true);
+        startGestation(env);
         setEnergy(getEnergy()+getAppConfig().gerbil_energy_loss_female_per_child*babies);
         setBabies(babies);
     } else {
@@ -115,6 +138,7 @@ void Animal::meetThis(Animal* A)
     }
     if( A->isFemale()) {
         A->setPregnant(true);
+        A->startGestation(env);
         A->setEnergy(A->getEnergy()+getAppConfig().gerbil_energy_loss_female_per_child*babies);
         A->setBabies(babies);
     } else {
@@ -127,112 +151,219 @@ void Animal::setPregnant(const bool& b)
     pregnant_ = b;
 }
 
-void Animal::UpdateState(sf::Time dt)
+void Animal::UpdateState(Environment& env)
 {
-    analyzeEnvironment();
-    if( isPregnant() ) time_gestation_+= dt;
-    if( time_gestation_>= time_gestation_limit_ ) {
-        setPregnant(false);
-        time_gestation_=sf::Time::Zero;
-        giveBirth();
-        state_ = GIVING_BIRTH;
-    }
+    // timed states (feeding, mating, ...) are left when their timer fires, see onTimer()
     if(state_ != FEEDING and state_ != MATING and state_ != GIVING_BIRTH and state_ != BABY and state_ != RUNNING_AWAY) {
         if(!food_sources_.empty()) {
             target_entity_=findClosest(food_sources_);
             if (isCollidingWithTarget()) {
                 target_position_memory_= target_entity_->getPosition();
-                eat();
-                state_ = FEEDING;
-                time_pause_feeding_= sf::seconds(1.5);
+                eat(env);
+                enterTimedState(env, FEEDING, sf::seconds(1.5));
             } else {
-                state_ = FOOD_IN_SIGHT;
+                changeState(env, FOOD_IN_SIGHT);
             }
         }
         if(!potential_mates_.empty()) {
             target_entity_=findClosest(potential_mates_);
             if (isCollidingWithTarget()) {
-                meet(target_entity_);
-                state_ = MATING;
+                meet(env, target_entity_);
             } else {
-                state_ = MATE_IN_SIGHT;
+                changeState(env, MATE_IN_SIGHT);
             }
         }
         if(!predators_.empty()) {
             predators_memory_ = predators_;
-            state_= RUNNING_AWAY;
+            enterTimedState(env, RUNNING_AWAY, sf::seconds(getAppConfig().animal_running_away));
         }
-    } else if (state_ == FEEDING ) {
-        time_pause_feeding_ -= dt;
-        if(time_pause_feeding_<=sf::Time::Zero) state_ = WANDERING;
-    } else if (state_ == MATING) {
-        time_pause_mating_ -= dt;
-        if (time_pause_mating_ <= sf::Time::Zero ) state_= WANDERING;
     }
-    if (state_ == GIVING_BIRTH) {
-        birth_pause_timer_ -= dt;
-        if (birth_pause_timer_ <= sf::Time::Zero ) state_= WANDERING;
-    }
-    else if (state_ == RUNNING_AWAY) {
-        time_running_away_ -= dt;
-        if (time_running_away_ <= sf::Time:: Zero) {
-            time_running_away_ = sf::seconds(getAppConfig().animal_running_away);
-            state_ = WANDERING;
-        }
+}
+
+void Animal::enterTimedState(Environment& env, State state, sf::Time duration)
+{
+    changeState(env, state);
+    timed_state_ = state;
+    env.defer([this, &env, duration] {
+        TimerWheel& timers(env.getTimers());
+        timers.cancel(state_timer_);
+        state_timer_ = timers.schedule(duration, this, END_OF_STATE);
+    });
+}
+
+void Animal::changeState(Environment& env, State state)
+{
+    UpdateBucket const bucket(getUpdateBucket());
+    state_ = state;
+    if (getUpdateBucket() != bucket) env.rebucket(this);
+}
+
+void Animal::startGestation(Environment& env)
+{
+    TimerWheel& timers(env.getTimers());
+    if (!timers.isPending(gestation_timer_)) {
+        gestation_timer_ = timers.schedule(time_gestation_limit_, this, END_OF_GESTATION);
     }
-    else if (state_== BABY) {
-        if( age_>=  sf::seconds(getAppConfig().gerbil_min_age_mating)) {
+}
+
+void Animal::onTimer(Environment& env, int kind)
+{
+    switch (kind) {
+    case END_OF_GESTATION:
+        gestation_timer_ = TimerWheel::NONE;
+        setPregnant(false);
+        giveBirth(env);
+        enterTimedState(env, GIVING_BIRTH, sf::seconds(getAppConfig().animal_delivery_time));
+        break;
+
+    case END_OF_STATE:
+        state_timer_ = TimerWheel::NONE;
+        perception_stale_ = true; // look around before choosing what to do next
+        // the timed state may have been replaced by a state without timer
+        if (state_ != timed_state_) break;
+        if (state_ == BABY) {
             grow();
             if (organic_entity_mum_!= nullptr) organic_entity_mum_->forgetChild(this);
             forgetMother();
-            state_= WANDERING;
         }
+        changeState(env, WANDERING);
+        break;
+
+    default:
+        break;
     }
 }
 
-void Animal::update(sf::Time dt)
+void Animal::scheduleTimers(Environment& env)
 {
-    UpdateState(dt);
-    Vec2d attractionForce;
+    perception_due_ = env.getTimers().getTime() + sf::seconds(env.nextPhase() * getPerceptionPeriod());
+    if (state_ == BABY) {
+        enterTimedState(env, BABY, sf::seconds(getAppConfig().gerbil_min_age_mating) - getAge());
+    }
+    if (isPregnant()) {
+        startGestation(env);
+    }
+}
+
+void Animal::cancelTimers(Environment& env)
+{
+    env.getTimers().cancel(state_timer_);
+    env.getTimers().cancel(gestation_timer_);
+}
+
+struct Animal::VirtualTraits
+{
+    static const double& viewRange(Animal const& animal)          { return animal.getViewRange(); }
+    static const double& viewDistance(Animal const& animal)       { return animal.getViewDistance(); }
+    static const double& randomWalkRadius(Animal const& animal)   { return animal.getRandomWalkRadius(); }
+    static const double& randomWalkDistance(Animal const& animal) { return animal.getRandomWalkDistance(); }
+    static const double& randomWalkJitter(Animal const& animal)   { return animal.getRandomWalkJitter(); }
+    static const double& standardMaxSpeed(Animal const& animal)   { return animal.getStandardMaxSpeed(); }
+    static const double& mass(Animal const& animal)               { return animal.getMass(); }
+    static double perceptionPeriod(Animal const& animal)          { return animal.getPerceptionPeriod(); }
+};
+
+void Animal::update(Environment& env, sf::Time dt)
+{
+    updateKernel<VirtualTraits>(env, dt);
+}
+
+void Animal::perceive(Environment& env, double period)
+{
+    const sf::Int64 now(env.getTimers().getTime().asMicroseconds());
+    const sf::Int64 due(perception_due_.asMicroseconds());
+    if (!perception_stale_ and now < due) return;
+
+    analyzeEnvironment(env);
+    perception_stale_ = false;
+    const sf::Int64 step(sf::seconds(period).asMicroseconds());
+    if (step > 0 and due <= now) {
+        // first multiple of the period after now, keeping the phase
+        perception_due_ = sf::microseconds(due + ((now - due) / step + 1) * step);
+    }
+}
+
+void Animal::wander(Environment& env, sf::Time dt)
+{
+    wanderKernel<VirtualTraits>(env, dt);
+}
+
+void Animal::hold(Environment& env, sf::Time dt)
+{
+    // the state may have changed since the animal was bucketed
+    if (getUpdateBucket() != HOLDING_BUCKET) {
+        update(env, dt);
+        return;
+    }
+    holdKernel(env, dt);
+}
+
+void Animal::holdKernel(Environment& env, sf::Time dt)
+{
+    if (state_ == FEEDING) speed_ *= ANIMAL_FEEDING_SPEED_FACTOR;
+    endMove(env, dt);
+}
+
+template <class Traits>
+void Animal::updateKernel(Environment& env, sf::Time dt)
+{
+    // by state, for the subclasses kept in another bucket too
+    if (Animal::getUpdateBucket() == HOLDING_BUCKET) {
+        holdKernel(env, dt);
+        return;
+    }
+    perceive(env, Traits::perceptionPeriod(*this) * env.getQuality().perception_stretch);
+    UpdateState(env);
+    actKernel<Traits>(env, dt);
+}
+
+template <class Traits>
+void Animal::wanderKernel(Environment& env, sf::Time dt)
+{
+    if (state_ != WANDERING) {
+        updateKernel<Traits>(env, dt);
+        return;
+    }
+    perceive(env, Traits::perceptionPeriod(*this) * env.getQuality().perception_stretch);
+    UpdateState(env);
+    if (state_ != WANDERING) {
+        actKernel<Traits>(env, dt);
+    } else if (!steerKernel<Traits>(env, dt.asSeconds(), randomWalkKernel<Traits>())) {
+        endMove(env, dt);
+    }
+}
+
+template <class Traits>
+void Animal::actKernel(Environment& env, sf::Time dt)
+{
+    const double deltaT(dt.asSeconds());
+    bool moving(false); // whether the move was left to the environment's SteeringBatch
 
     switch( state_) {
-    case FOOD_IN_SIGHT  : {
-        if (target_entity_ == nullptr) { state_ = WANDERING; break; }
-        Vec2d targetPos = target_entity_->getPosition();
-        attractionForce = force(targetPos);
-        moveToVec2dForce(dt.asSeconds(), attractionForce);
+    case FOOD_IN_SIGHT  :
+    case MATE_IN_SIGHT  :
+        if (target_entity_ == nullptr) { changeState(env, WANDERING); break; }
+        moving = seekKernel<Traits>(env, deltaT, target_entity_->getPosition());
         break;
-    }
     case WANDERING  :
-        attractionForce= randomWalk();
-        moveToVec2dForce(dt.asSeconds(), attractionForce);
-        break;
-    case MATE_IN_SIGHT: {
-        if (target_entity_ == nullptr) { state_ = WANDERING; break; }
-        Vec2d targetPos = target_entity_->getPosition();
-        attractionForce = force(targetPos);
-        moveToVec2dForce(dt.asSeconds(), attractionForce);
+        moving = steerKernel<Traits>(env, deltaT, randomWalkKernel<Traits>());
         break;
-    }
     case RUNNING_AWAY:
-        attractionForce = calculateFleeForce(predators_memory_);
-        moveToVec2dForce(dt.asSeconds(), attractionForce);
-        break;
-    case FEEDING:
-        speed_ *=ANIMAL_FEEDING_SPEED_FACTOR;
-        moveToVec2dForce(dt.asSeconds(), force(target_position_memory_));
+        moving = steerKernel<Traits>(env, deltaT, calculateFleeForce(predators_memory_));
         break;
     case BABY: {
         if ((organic_entity_mum_ != nullptr)) {
-            moveToVec2dForce(dt.asSeconds(), force(organic_entity_mum_->getPosition())) ;
+            moving = seekKernel<Traits>(env, deltaT, organic_entity_mum_->getPosition());
         } else {
-            OrganicEntity* nearestParent(findClosest(getVisibleEntities()));
+            OrganicEntity* nearestParent(env.findClosestInSight(this, [](OrganicEntity const*) {
+                return true;
+            }));
             if(nearestParent != nullptr) {
                 if( (!eatable(nearestParent)) and !(nearestParent->eatable(this)))
-                    moveToVec2dForce(dt.asSeconds(), force(findClosest(getVisibleEntities())->getPosition()));
+                    moving = seekKernel<Traits>(env, deltaT, nearestParent->getPosition());
             }
             else {
-                moveToVec2dForce(dt.asSeconds(), randomWalk());
+                moving = steerKernel<Traits>(env, deltaT, randomWalkKernel<Traits>());
             }
         }
         break;
@@ -241,8 +372,51 @@ void Animal::update(sf::Time dt)
         break;
     }
 
+    if (!moving) endMove(env, dt);
+}
+
+template <class Traits>
+bool Animal::seekKernel(Environment& env, double deltaT, const Vec2d& target)
+{
+    SteeringBatch& steering(env.getSteering());
+    if (!steering.isOpen()) {
+        moveKernel<Traits>(deltaT, forceKernel<Traits>(target));
+        return false;
+    }
+    steering.seek(this, getPosition(), direction_, speed_, maxSpeedKernel<Traits>(), Traits::mass(*this), target);
+    return true;
+}
+
+template <class Traits>
+bool Animal::steerKernel(Environment& env, double deltaT, const Vec2d& force)
+{
+    SteeringBatch& steering(env.getSteering());
+    if (!steering.isOpen()) {
+        moveKernel<Traits>(deltaT, force);
+        return false;
+    }
+    steering.push(this, getPosition(), direction_, speed_, maxSpeedKernel<Traits>(), Traits::mass(*this), force);
+    return true;
+}
+
+void Animal::applySteering(Environment& env, sf::Time dt, const Vec2d& position, const Vec2d& direction, double speed)
+{
+    setPosition(position);
+    direction_ = direction;
+    speed_ = speed;
+    endMove(env, dt);
+}
+
+void Animal::endMove(Environment& env, sf::Time dt)
+{
+    // the obstacles are looked up in a shared grid, and the energy is read
+    // by the other tiles
+    if (env.isDeferring()) {
+        env.defer([this, &env, dt] { endMove(env, dt); });
+        return;
+    }
     // Bounce off obstacles
-    for (const auto& obstacle : getAppEnv().getIsColliding(this)) {
+    env.forEachColliding(*this, [this](CircularCollider* obstacle) {
         Vec2d toAnimal = directionTo(obstacle->getPosition()) * -1;
         double overlap = getRadius() + obstacle->getRadius() - distanceTo(obstacle->getPosition());
         if (overlap > 0) {
@@ -250,23 +424,26 @@ void Animal::update(sf::Time dt)
             setPosition(getPosition() + normal * overlap);
             direction_ = (direction_ - normal * 2.0 * direction_.dot(normal)).normalised();
         }
-    }
+    });
 
     updateEnergy(dt);
 }
 
 Vec2d Animal::force( const Vec2d& target ) const
 {
-    if (!isEqual(directionTo(target).length(),0)) {
-        double deceleration(ANIMAL_DECELERATION);
-        double speed;
-        if(directionTo(target).length()/(deceleration) <= getMaxSpeed()) {
-            speed = directionTo(target).length()/(deceleration) ;
-        }
-        else {
-            speed = getMaxSpeed() ;
-        }
-        Vec2d desired_velocity = directionTo(target)/directionTo(target).length()*speed;
+    return forceKernel<VirtualTraits>(target);
+}
+
+template <class Traits>
+Vec2d Animal::forceKernel(const Vec2d& target) const
+{
+    const Vec2d toTarget(directionTo(target));
+    const double distance(toTarget.length());
+    if (!isEqual(distance,0)) {
+        const double brake(distance/ANIMAL_DECELERATION);
+        const double maxSpeed(maxSpeedKernel<Traits>());
+        const double speed(brake <= maxSpeed ? brake : maxSpeed);
+        Vec2d desired_velocity = toTarget/distance*speed;
         return desired_velocity-speed_*direction_;
     }
     return direction_;
@@ -305,21 +482,21 @@ void Animal::drawText(sf::RenderTarget& targetWindow) const
 {
     targetWindow.draw(buildDebugText(stateToString(), 110, sf::Color::Red));
     targetWindow.draw(buildDebugText("Age_limit:" + to_nice_string(age_limit_.asSeconds()) +
-                                     " Age:" + to_nice_string(age_.asSeconds()), 90, sf::Color::Blue));
+                                     " Age:" + to_nice_string(getAge().asSeconds()), 90, sf::Color::Blue));
     targetWindow.draw(buildDebugText("Energy limit:" + to_nice_string(getAppConfig().animal_min_energy) +
                                      " Energy:" + to_nice_string(energy_), 70, sf::Color::Blue));
 
     if (isFemale()) {
         targetWindow.draw(buildDebugText("Female  babies:" + to_nice_string(getBabies()) +
                                          " Gestation_limit:" + to_nice_string(time_gestation_limit_.asSeconds()) +
-                                         " Gestation:" + to_nice_string(time_gestation_.asSeconds()), 50, sf::Color::Magenta));
+                                         " Birth at:" + to_nice_string(getDeadline(gestation_timer_).asSeconds()), 50, sf::Color::Magenta));
     } else {
         targetWindow.draw(buildDebugText("Male", 50, sf::Color::Blue));
     }
 
     if (state_ == GIVING_BIRTH) {
-        targetWindow.draw(buildDebugText("pause GivingBirth " +
-                                         to_nice_string(birth_pause_timer_.asSeconds()), 150, sf::Color::Cyan));
+        targetWindow.draw(buildDebugText("pause GivingBirth until " +
+                                         to_nice_string(getDeadline(state_timer_).asSeconds()), 150, sf::Color::Cyan));
     }
 
     if (pregnant_) targetWindow.draw(buildAnnulus(getPosition(), 50, sf::Color::Magenta, 2));
@@ -342,31 +519,62 @@ double Animal::getRotation() const
 
 void Animal::setRotation(const double& angle )
 {
-    direction_.x = cos(angle);
-    direction_.y= sin(angle);
+    direction_ = Vec2d::fromAngle(angle);
 }
 
 bool Animal::isTargetInSight(const Vec2d& target) const
 {
-    if(isEqual(distanceTo(target),0 )) return false;
-    if ( (target-getPosition()).lengthSquared() <= (getViewDistance()*getViewDistance())) {
-        if(direction_.dot((target-getPosition()).normalised()) >= cos((getViewRange()+ANIMAL_VIEW_RANGE_EPSILON)/2)) {
-            return true;
-        }
+    ViewCone const cone(getPosition(), direction_, getViewCosHalfAngle(), getViewDistance());
+#ifdef INFOSV_FIXED_POINT
+    // the position is rounded to a step of the torus: round the target the
+    // same way, so that a target on the animal is at distance 0 from it
+    double const size(getAppConfig().simulation_world_size);
+    return cone.contains(TorusPoint(target, size).toVec2d(size));
+#else
+    return cone.contains(target);
+#endif
+}
+
+const ViewCone& Animal::getViewCone() const
+{
+    return view_cone_;
+}
+
+void Animal::refreshViewCone()
+{
+    view_cone_ = ViewCone(getPosition(), direction_, getViewCosHalfAngle(), getViewDistance());
+}
+
+double Animal::getViewCosHalfAngle() const
+{
+    if (getViewRange() != view_cos_range_) {
+        view_cos_range_ = getViewRange();
+        view_cos_half_angle_ = cos((view_cos_range_ + ANIMAL_VIEW_RANGE_EPSILON) / 2);
     }
-    if (isEqual(0,distanceTo(target))) return true;
-    return false;
+    return view_cos_half_angle_;
 }
 
 Vec2d Animal::randomWalk()
+{
+    return randomWalkKernel<VirtualTraits>();
+}
+
+template <class Traits>
+Vec2d Animal::randomWalkKernel()
 {
     Vec2d random_vec(uniform(-1.0,1.0),uniform(-1.0,1.0));
-    current_target_ += random_vec * getRandomWalkJitter()*3;
-    current_target_ = current_target_.normalised()*getRandomWalkRadius();
-    Vec2d moved_current_target = current_target_ + Vec2d(getRandomWalkDistance(), 0);
-    random_walk_target_= ConvertToGlobalCoord(moved_current_target);
+    current_target_ += random_vec * Traits::randomWalkJitter(*this)*3;
+    current_target_ = current_target_.normalised()*Traits::randomWalkRadius(*this);
+    Vec2d moved_current_target = current_target_ + Vec2d(Traits::randomWalkDistance(*this), 0);
+    // ConvertToGlobalCoord() without the translation, rotating by the
+    // direction itself rather than through an sf::Transform
+    const double length(direction_.length());
+    const Vec2d heading(isEqual(length, 0) ? Vec2d(1, 0) : direction_/length);
+    const Vec2d walk(heading.x*moved_current_target.x - heading.y*moved_current_target.y,
+                     heading.y*moved_current_target.x + heading.x*moved_current_target.y);
+    random_walk_target_ = getPosition() + walk;
 
-    return ConvertToGlobalCoord(moved_current_target)-getPosition();
+    return walk;
 }
 
 void Animal::drawRandomWalkCircle(sf::RenderTarget& targetWindow) const
@@ -404,18 +612,31 @@ void Animal::moveToVec2dForce(const sf::Time& dt,const Vec2d& force)
 
 void Animal::moveToVec2dForce(const double& deltaT,const Vec2d& force)
 {
-    Vec2d acceleration=force/getMass();
+    moveKernel<VirtualTraits>(deltaT, force);
+}
+
+template <class Traits>
+void Animal::moveKernel(double deltaT, const Vec2d& force)
+{
+    Vec2d acceleration=force/Traits::mass(*this);
     Vec2d current_velocity = speed_*direction_;
     Vec2d new_velocity= current_velocity+acceleration*deltaT;
     direction_=new_velocity.normalised();
-    if (new_velocity.length() > getMaxSpeed()) new_velocity=direction_*getMaxSpeed();
+    const double maxSpeed(maxSpeedKernel<Traits>());
+    if (new_velocity.isLongerThan(maxSpeed)) new_velocity=direction_*maxSpeed;
     setPosition(getPosition()+new_velocity*deltaT);
     speed_=new_velocity.length();
 }
 
 double Animal::getMaxSpeed() const
 {
-    double maxSpeed= (double)(getStandardMaxSpeed());
+    return maxSpeedKernel<VirtualTraits>();
+}
+
+template <class Traits>
+double Animal::maxSpeedKernel() const
+{
+    double maxSpeed(Traits::standardMaxSpeed(*this));
     switch(state_) {
     case FOOD_IN_SIGHT  :
         maxSpeed *=ANIMAL_SPEED_FACTOR_FOOD;
@@ -471,26 +692,38 @@ void Animal::updateEnergy( sf::Time dt)
     OrganicEntity::setEnergy(getEnergy()-energyLoss);
 }
 
-void Animal::eat()
+void Animal::eat(Environment& env)
 {
     if (target_entity_ == nullptr) return;
-    setEnergy(getEnergy()+ANIMAL_EATING_EFFICIENCY*target_entity_->getEnergy());
-    target_entity_->setEnergy(0);
+    OrganicEntity* const prey(target_entity_);
+    env.defer([this, &env, prey] {
+        setEnergy(getEnergy()+ANIMAL_EATING_EFFICIENCY*prey->getEnergy());
+        prey->setEnergy(0);
+        env.markForDeath(prey);
+    });
 }
 
-void Animal::analyzeEnvironment()
+void Animal::analyzeEnvironment(Environment const& env)
 {
+    refreshViewCone();
     potential_mates_.clear();
-    predators_.clear();
     food_sources_.clear();
-    potential_mates_ = mates(getVisibleEntities());
-    food_sources_ = filterEdible(getVisibleEntities());
-    predators_= filterPredators(getVisibleEntities());
+    predators_.clear();
+    // one lookup in the species table sorts each visible entity
+    env.forEachInSight(this, [this, &env](OrganicEntity* OE) {
+        const std::uint8_t seen(interaction(getSpecies(), OE->getSpecies()));
+        if ((seen & MATE) and matable(OE) and OE->matable(this)) potential_mates_.push_back(OE);
+        if (seen & PREY) {
+            food_sources_.push_back(OE);
+            env.alert(OE);
+        }
+        if (seen & PREDATOR) predators_.push_back(OE);
+    });
 }
 
-std::list<OrganicEntity*> Animal::getVisibleEntities()
+std::list<OrganicEntity*> Animal::getVisibleEntities(Environment const& env)
 {
-    return getAppEnv().getEntitiesInSightForAnimal(this);
+    return env.getEntitiesInSightForAnimal(this);
 }
 
 std::list<OrganicEntity*> Animal::filterEdible(const std::list <OrganicEntity*>& entities)
@@ -498,7 +731,7 @@ std::list<OrganicEntity*> Animal::filterEdible(const std::list <OrganicEntity*>&
     std::list<OrganicEntity*> result;
     if (!entities.empty()) {
         for (const auto& OE : entities) {
-            if(eatable(OE)) result.push_back(OE);
+            if(interaction(getSpecies(), OE->getSpecies()) & PREY) result.push_back(OE);
         }
     }
     return result;
@@ -515,14 +748,15 @@ std::list<OrganicEntity*> Animal::mates(const std::list <OrganicEntity*>& entiti
     return result;
 }
 
-OrganicEntity* Animal::findClosest(const std::list<OrganicEntity*>& entities) const
+OrganicEntity* Animal::findClosest(const Entities& entities) const
 {
     OrganicEntity* closest(nullptr);
     if (!entities.empty()) {
         double dmin(std::numeric_limits<double>::max());
         for (const auto& OE : entities) {
-            if(distanceTo(OE->getPosition()) <= dmin ) {
-                dmin=distanceTo(OE->getPosition());
+            const double distance(distanceTo(OE->getPosition()));
+            if(distance <= dmin ) {
+                dmin=distance;
                 closest=OE;
             }
         }
@@ -534,23 +768,20 @@ std::list<OrganicEntity*> Animal::filterPredators( const std::list<OrganicEntity
 {
     std::list<OrganicEntity*> predators;
     for (const auto& OE : env ) {
-        if (OE->eatable(this))
+        if (interaction(getSpecies(), OE->getSpecies()) & PREDATOR)
             predators.push_back(OE);
     }
     return predators;
 }
 
-Vec2d Animal::calculateFleeForce( const std::list<OrganicEntity*>& entities )
+Vec2d Animal::calculateFleeForce( const Entities& entities )
 {
     Vec2d resultForce ;
-    double flee_strength(ANIMAL_FLEE_STRENGTH);
-    double distance_exponent(ANIMAL_FLEE_DISTANCE_EXPONENT) ;
+    // |d|^e computed as (d.d)^(e/2): one pow and no square root per predator
+    const double half_exponent(ANIMAL_FLEE_DISTANCE_EXPONENT/2);
     for (const auto& OE : entities ) {
-        resultForce +=
-            ( flee_strength*(OE->getPosition() - getPosition())
-              /
-              ( pow((OE->getPosition()
-                     - getPosition()).length(),distance_exponent))  ) ;
+        const Vec2d away(OE->getPosition() - getPosition());
+        resultForce += ANIMAL_FLEE_STRENGTH*away/pow(away.lengthSquared(), half_exponent);
     }
     return -1*resultForce;
 }
@@ -560,6 +791,17 @@ const bool& Animal::isPregnant() const
     return pregnant_;
 }
 
+bool Animal::canMate(Animal const& partner) const
+{
+    SpeciesParameters const& species(speciesParameters(getSpecies()));
+    Config const& config(getAppConfig());
+    return getAge().asSeconds() >= config.*species.min_age_mating
+        and getEnergy() >= config.*(isFemale() ? species.energy_min_mating_female
+                                               : species.energy_min_mating_male)
+        and !isPregnant()
+        and isFemale() != partner.isFemale();
+}
+
 bool Animal::isCollidingWithTarget() const
 {
     if (target_entity_ == nullptr) return false;
@@ -601,8 +843,10 @@ void Animal::forgetAll()
 
 void Animal::forgetEntity(OrganicEntity* entity)
 {
+    const std::size_t seen(food_sources_.size() + potential_mates_.size() + predators_.size());
     if (target_entity_ == entity) {
         target_entity_ = nullptr;
+        perception_stale_ = true;
     }
     if (organic_entity_mum_ == entity) {
         organic_entity_mum_ = nullptr;
@@ -611,6 +855,41 @@ void Animal::forgetEntity(OrganicEntity* entity)
     potential_mates_.remove(entity);
     predators_.remove(entity);
     predators_memory_.remove(entity);
+    if (food_sources_.size() + potential_mates_.size() + predators_.size() != seen) {
+        perception_stale_ = true;
+    }
+}
+
+void Animal::alert()
+{
+    perception_stale_ = true;
+}
+
+void Animal::prepareUpdate(Environment& env)
+{
+    // holding animals don't look around, see hold()
+    if (getUpdateBucket() == HOLDING_BUCKET) return;
+    perceive(env, getPerceptionPeriod() * env.getQuality().perception_stretch);
+}
+
+std::size_t Animal::getHeapBytes() const
+{
+    return potential_mates_.heapBytes() + predators_.heapBytes() + food_sources_.heapBytes()
+           + predators_memory_.heapBytes() + organic_entity_kids_.heapBytes();
+}
+
+OrganicEntity::UpdateBucket Animal::getUpdateBucket() const
+{
+    switch (state_) {
+    case WANDERING:
+        return WANDERING_BUCKET;
+    case FEEDING:
+    case MATING:
+    case GIVING_BIRTH:
+        return HOLDING_BUCKET;
+    default:
+        return ACTIVE_BUCKET;
+    }
 }
 
 int Animal::getState() const
@@ -624,4 +903,10 @@ OrganicEntity* Animal::getClosestEdible() const
         return findClosest(food_sources_);
     }
     return nullptr;
-}
\ No newline at end of file
+}
+
+// kernels of the SpeciesAnimal species, see SpeciesAnimal.hpp
+template void Animal::updateKernel<GerbilTraits>(Environment&, sf::Time);
+template void Animal::updateKernel<ScorpionTraits>(Environment&, sf::Time);
+template void Animal::wanderKernel<GerbilTraits>(Environment&, sf::Time);
+template void Animal::wanderKernel<ScorpionTraits>(Environment&, sf::Time);
@@ -1,11 +1,14 @@
 #pragma once
 #include "../Environment/OrganicEntity.hpp"
+#include "../Environment/TimerWheel.hpp"
+#include "../Utility/SmallVector.hpp"
 #include "../Utility/Vec2d.hpp"
+#include "ViewCone.hpp"
 #include <SFML/Graphics.hpp>
 #include <iostream>
 class Environment;
 
-enum State {
+enum State : std::uint8_t {
     FOOD_IN_SIGHT, // food in sight
     FEEDING,       // eating (at this point it stops moving)
     RUNNING_AWAY,  // fleeing
@@ -20,6 +23,21 @@ class Animal : public OrganicEntity
 {
 
 public:
+    /**
+     * @brief Entities an animal keeps track of (seen, fled from, kids)
+     *
+     * Two fit inline, which covers most animals most of the time.
+     */
+    typedef SmallVector<OrganicEntity*, 2> Entities;
+
+    /**
+     * @brief Kinds of the timers an animal schedules
+     */
+    enum Timer {
+        END_OF_STATE,     ///< the current timed state is over
+        END_OF_GESTATION  ///< time to give birth
+    };
+
     /**
      * @brief Constructor for the Animal class
      * 
@@ -113,6 +131,44 @@ public:
     void forgetMother() override;
     void forgetEntity(OrganicEntity* entity) override;
 
+    /**
+     * @brief Makes the animal perceive again at its next update
+     *
+     * Called by predators seeing it, so that it doesn't wait for its
+     * perception period to notice them.
+     */
+    void alert() override;
+
+    /**
+     * @brief Perceives ahead of the update, if the perception is due
+     */
+    void prepareUpdate(Environment& env) override;
+
+    /**
+     * @brief Heap blocks of the lists that outgrew their inline storage
+     */
+    std::size_t getHeapBytes() const override;
+
+    /**
+     * @brief Buckets the animals by state: WANDERING_BUCKET for WANDERING,
+     *        HOLDING_BUCKET for FEEDING, MATING and GIVING_BIRTH, and
+     *        ACTIVE_BUCKET for the others
+     */
+    UpdateBucket getUpdateBucket() const override;
+
+    /**
+     * @brief Gets the time between two perceptions of the environment
+     *
+     * Between two perceptions the animal acts on what it saw last, except
+     * when alerted or when one of the entities it saw dies.
+     *
+     * @return Period in seconds; 0 to perceive at every update
+     */
+    virtual double getPerceptionPeriod() const
+    {
+        return 0;
+    }
+
     /**
      * @brief Removes the reference to a specific baby
      *
@@ -169,6 +225,28 @@ public:
     Vec2d getDirection() const;
     const bool& isPregnant() const;
 
+    /**
+     * @brief Checks if the animal is ready to mate with a partner
+     *
+     * The thresholds are those of SPECIES_PARAMETERS for the animal's species,
+     * which must be one that mates.
+     *
+     * @param partner Animal of a species this one can mate with
+     * @return true if old enough, fed enough, not pregnant and of the other sex
+     */
+    bool canMate(Animal const& partner) const;
+
+    /**
+     * @brief Ends an update whose move was left to the SteeringBatch
+     *
+     * @param env Environment the animal lives in
+     * @param dt Time elapsed since last update
+     * @param position Position computed by the batch
+     * @param direction Direction computed by the batch
+     * @param speed Speed computed by the batch
+     */
+    void applySteering(Environment& env, sf::Time dt, const Vec2d& position, const Vec2d& direction, double speed);
+
     virtual const double& getViewRange() const = 0;
     virtual const double& getViewDistance() const = 0;
     virtual const double& getRandomWalkRadius() const = 0;
@@ -181,11 +259,22 @@ public:
     /**
      * @brief Checks if a target is within the animal's field of view
      * 
+     * A target at the animal's own position counts as seen.
+     *
      * @param target Target position to check
      * @return True if target is visible, false otherwise
      */
     bool isTargetInSight(const Vec2d& target) const;
 
+    /**
+     * @brief Gets the field of view as of the last analyzeEnvironment()
+     *
+     * Used by the Environment to test all the entities at once.
+     *
+     * @return the animal's view cone
+     */
+    const ViewCone& getViewCone() const;
+
     /**
      * @brief Generates random movement vector
      * 
@@ -203,7 +292,7 @@ public:
 
     std::list<OrganicEntity*> filterEdible(const std::list<OrganicEntity*>&); // takes a list of OE and returns those that are edible
     std::list<OrganicEntity*> mates(const std::list<OrganicEntity*>&);     // takes a list of OE and returns those with which to reproduce
-    OrganicEntity* findClosest(const std::list<OrganicEntity*>&) const;      // takes a list of OE and returns the closest one
+    OrganicEntity* findClosest(const Entities&) const;      // takes a list of OE and returns the closest one
 
 protected:
     Vec2d force(const Vec2d&) const;        // returns a force from a Vec2d position
@@ -236,25 +325,184 @@ protected:
      * - WANDERING: Uses random walk algorithm
      * - MATE_IN_SIGHT: Moves toward potential mate
      * - RUNNING_AWAY: Flees from predators
-     * - FEEDING: Slows down movement and stays near food
+     * - FEEDING, MATING, GIVING_BIRTH: Stays put, see hold()
      * - BABY: Follows mother or moves toward nearest non-threatening entity
      * 
+     * @param env Environment the animal lives in
+     * @param dt Time elapsed since last update
+     */
+    virtual void update(Environment& env, sf::Time dt) override;
+
+    /**
+     * @brief update() of a wandering animal
+     */
+    virtual void wander(Environment& env, sf::Time dt) override;
+
+    /**
+     * @brief update() of an animal feeding, mating or giving birth
+     *
+     * The animal stays where it is, slowing down if feeding, until the
+     * timer of its state ends it: it neither looks around nor decides
+     * anything before, and its perception is stale by then.
+     */
+    void hold(Environment& env, sf::Time dt) override;
+
+    /**
+     * @brief Reads the species parameters through the virtual getters
+     */
+    struct VirtualTraits;
+
+    /**
+     * @brief update() with the species parameters read through Traits
+     *
+     * force(), randomWalk(), moveToVec2dForce() and getMaxSpeed() have
+     * kernels too, so that for the traits of a SpeciesAnimal the whole
+     * movement is made of direct calls the compiler can inline. The non
+     * template functions are the kernels for VirtualTraits. Defined and
+     * explicitly instantiated in Animal.cpp.
+     *
+     * @tparam Traits VirtualTraits or the traits of a SpeciesAnimal
+     * @param env Environment the animal lives in
+     * @param dt Time elapsed since last update
+     */
+    template <class Traits>
+    void updateKernel(Environment& env, sf::Time dt);
+
+    /**
+     * @brief wander() with the species parameters read through Traits
+     *
+     * Goes on with the random walk unless what the animal sees changes its
+     * state.
+     */
+    template <class Traits>
+    void wanderKernel(Environment& env, sf::Time dt);
+
+    /**
+     * @brief Moves as the state decided by UpdateState() says, the end
+     *        of updateKernel()
+     */
+    template <class Traits>
+    void actKernel(Environment& env, sf::Time dt);
+
+    /**
+     * @brief hold() of an animal known to be feeding, mating or giving birth
+     */
+    void holdKernel(Environment& env, sf::Time dt);
+
+    /**
+     * @brief Calls analyzeEnvironment() if the perception is due or stale
+     *
+     * Periodic perceptions keep the phase the animal got when added, so
+     * that the animals of a species spread their perceptions evenly over
+     * the period.
+     *
+     * @param env Environment the animal lives in
+     * @param period Perception period in seconds
+     */
+    void perceive(Environment& env, double period);
+
+    template <class Traits>
+    Vec2d forceKernel(const Vec2d& target) const;
+
+    template <class Traits>
+    Vec2d randomWalkKernel();
+
+    template <class Traits>
+    void moveKernel(double deltaT, const Vec2d& force);
+
+    template <class Traits>
+    double maxSpeedKernel() const;
+
+    /**
+     * @brief Moves toward a target, or leaves the move to the environment
+     *
+     * While the environment's SteeringBatch is open the animal is added to it
+     * and moved with the rest of the population; otherwise it moves at once.
+     *
+     * @param env Environment the animal lives in
+     * @param deltaT Time elapsed in seconds
+     * @param target Position sought
+     * @return true if the move was left to the batch
+     */
+    template <class Traits>
+    bool seekKernel(Environment& env, double deltaT, const Vec2d& target);
+
+    /**
+     * @brief Same as seekKernel() for a given steering force
+     */
+    template <class Traits>
+    bool steerKernel(Environment& env, double deltaT, const Vec2d& force);
+
+    /**
+     * @brief Bounces off the obstacles and pays for the move
+     * @param env Environment the animal lives in
      * @param dt Time elapsed since last update
      */
-    virtual void update(sf::Time dt) override;
+    void endMove(Environment& env, sf::Time dt);
     
     /**
      * @brief Manages the animal's state transitions
      * 
-     * Handles the complex state machine governing animal behavior by:
-     * - Analyzing the environment to detect food, mates, and predators
-     * - Managing pregnancy progression and birth
-     * - Prioritizing state transitions based on survival needs
-     * - Processing time-dependent state durations
+     * Handles the complex state machine governing animal behavior by
+     * prioritizing state transitions based on survival needs, from the food,
+     * mates and predators found by the last perception (see perceive()).
+     *
+     * Time-dependent states (feeding, mating, giving birth, running away,
+     * baby) and pregnancy are not counted down here: they are scheduled on
+     * the environment's TimerWheel when they start and end in onTimer().
      * 
-     * @param dt Time elapsed since the last update
+     * @param env Environment the animal lives in
      */
-    void UpdateState(sf::Time dt);
+    void UpdateState(Environment& env);
+
+    /**
+     * @brief Enters a state that ends by itself after some time
+     *
+     * Replaces any state timer still pending.
+     *
+     * @param env Environment holding the timers
+     * @param state The timed state
+     * @param duration How long the state lasts
+     */
+    void enterTimedState(Environment& env, State state, sf::Time duration);
+
+    /**
+     * @brief Sets the state, telling the environment when the update
+     *        bucket changes with it
+     *
+     * @param env Environment the animal lives in
+     * @param state The new state
+     */
+    void changeState(Environment& env, State state);
+
+    /**
+     * @brief Schedules the birth, unless it already is
+     *
+     * @param env Environment holding the timers
+     */
+    void startGestation(Environment& env);
+
+    /**
+     * @brief Ends a timed state or a pregnancy
+     *
+     * @param env Environment the animal lives in
+     * @param kind END_OF_STATE or END_OF_GESTATION
+     */
+    void onTimer(Environment& env, int kind) override;
+
+    /**
+     * @brief Schedules the timers of a newly added animal (babyhood, pregnancy)
+     *
+     * @param env Environment the animal was added to
+     */
+    void scheduleTimers(Environment& env) override;
+
+    /**
+     * @brief Cancels the pending timers of a dying animal
+     *
+     * @param env Environment holding the timers
+     */
+    void cancelTimers(Environment& env) override;
     
     /**
      * @brief Updates animal's energy level
@@ -268,22 +516,26 @@ protected:
     /**
      * @brief Consumes target entity
      * 
-     * Animal gains 70% of target's energy and sets target's energy to 0
+     * Animal gains 70% of target's energy and sets target's energy to 0.
+     * The target is marked for death, which static targets (food) need.
+     *
+     * @param env Environment the target lives in
      */
-    void eat();
+    void eat(Environment& env);
 
     /**
      * @brief Handles mating between animals
      * 
+     * @param env Environment holding the timers of the mating and gestation
      * @param A Pointer to another animal for mating
      * 
      * Manages reproduction between two animals. Changes state to MATING,
      * randomly determines number of babies, updates pregnancy status and
      * adjusts energy levels for both animals based on gender and configuration.
      */
-    void meetThis(Animal* A);
-    void meet(OrganicEntity*);
-    void giveBirth() override;
+    void meetThis(Environment& env, Animal* A);
+    void meet(Environment& env, OrganicEntity*);
+    void giveBirth(Environment& env) override;
 
     int getState() const;
     
@@ -291,13 +543,22 @@ protected:
      * @brief Analyzes surrounding environment
      * 
      * Identifies food, mates, and predators in the animal's field of view
+     *
+     * @param env Environment the animal lives in
      */
-    void analyzeEnvironment();
+    void analyzeEnvironment(Environment const& env);
 
-    Vec2d calculateFleeForce(const std::list<OrganicEntity*>& entities);
+    /**
+     * @brief Rebuilds the view cone from the current position and heading
+     *
+     * Called once per tick by analyzeEnvironment().
+     */
+    void refreshViewCone();
+
+    Vec2d calculateFleeForce(const Entities& entities);
     std::list<OrganicEntity*> filterPredators(const std::list<OrganicEntity*>&);
 
-    std::list<OrganicEntity*> getVisibleEntities();
+    std::list<OrganicEntity*> getVisibleEntities(Environment const& env);
 
     void setState(const int&);
     void setState(const std::string&);
@@ -318,35 +579,43 @@ protected:
      */
     void setBabies(const int& n);
 
-    std::list<OrganicEntity*> organic_entity_kids_;
+    Entities organic_entity_kids_;
 
     OrganicEntity* getClosestEdible() const;
 
-private:
     void setRotation(const double&);
+
+private:
+
+    /**
+     * @brief Cosine of half the view range, recomputed only when the range changes
+     */
+    double getViewCosHalfAngle() const;
+
+    // largest members first, the small ones packed together at the end
     Vec2d direction_;
-    double speed_;
     Vec2d current_target_;
-    bool is_female_;
-    double energy_consumption_factor_;
     Vec2d random_walk_target_;
-    double viewRange_;
-    double viewDistance_;
-    sf::Time time_pause_feeding_;
-    State state_;
-    OrganicEntity* target_entity_;
-    bool pregnant_;
-    int babies_;
-    sf::Time birth_pause_timer_;
-    sf::Time time_pause_mating_;
-    sf::Time time_gestation_limit_; // maximum duration of gestation (9 months for humans for example)
-    sf::Time time_gestation_; // time elapsed since fertilization
-    sf::Time time_running_away_;
-    std::list<OrganicEntity*> potential_mates_;
-    std::list<OrganicEntity*> predators_;
-    std::list<OrganicEntity*> food_sources_;
-    std::list<OrganicEntity*> predators_memory_;
-    Vec2d flee_force_memory_;
     Vec2d target_position_memory_;
+    ViewCone view_cone_;
+    double speed_;
+    double energy_consumption_factor_;
+    mutable double view_cos_range_;      ///< view range view_cos_half_angle_ was computed for
+    mutable double view_cos_half_angle_; ///< cached cos((view range + epsilon) / 2)
+    OrganicEntity* target_entity_;
     OrganicEntity* organic_entity_mum_;
+    Entities potential_mates_;
+    Entities predators_;
+    Entities food_sources_;
+    Entities predators_memory_;
+    sf::Time time_gestation_limit_; // maximum duration of gestation (9 months for humans for example)
+    sf::Time perception_due_;            ///< environment time of the next periodic perception
+    TimerWheel::Handle state_timer_;     ///< ends timed_state_; the wheel knows when
+    TimerWheel::Handle gestation_timer_; ///< birth
+    int babies_;
+    State state_;
+    State timed_state_;                  ///< state state_timer_ ends
+    bool is_female_;
+    bool pregnant_;
+    bool perception_stale_;              ///< perceive at the next update, whatever the period
 };
\ No newline at end of file
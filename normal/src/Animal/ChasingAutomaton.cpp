@@ -41,7 +41,7 @@ void ChasingAutomaton::move(const double& deltaT)
     Vec2d current_velocity = speed_*direction_;
     Vec2d new_velocity = current_velocity+acceleration*deltaT;
     direction_ = new_velocity.normalised();
-    if (new_velocity.length() > getStandardMaxSpeed()) new_velocity = direction_*getStandardMaxSpeed();
+    if (new_velocity.isLongerThan(getStandardMaxSpeed())) new_velocity = direction_*getStandardMaxSpeed();
     setPosition(getPosition()+new_velocity*deltaT);
     speed_ = new_velocity.length();
 }
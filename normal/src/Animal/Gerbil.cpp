@@ -6,24 +6,32 @@
 #include "Animal.hpp"
 Gerbil::Gerbil(const Vec2d& position, const double& energy,
                const bool& isFemale) :
-    Animal(position,getAppConfig().gerbil_size, energy, isFemale
+    SpeciesAnimal(position,getAppConfig().gerbil_size, energy, isFemale
     , getAppConfig().gerbil_longevity
     , getAppConfig().gerbil_energy_loss_factor
     , getAppConfig().gerbil_gestation_time)
-{}
-Gerbil::Gerbil(const Vec2d& position) : Animal(position,getAppConfig().gerbil_size,getAppConfig().gerbil_energy_initial,uniform(0, 1) == 0,
+{
+    species_ = Species::GERBIL;
+}
+Gerbil::Gerbil(const Vec2d& position) : SpeciesAnimal(position,getAppConfig().gerbil_size,getAppConfig().gerbil_energy_initial,uniform(0, 1) == 0,
             getAppConfig().gerbil_longevity,
-            getAppConfig().gerbil_energy_loss_factor, getAppConfig().gerbil_gestation_time )   {}
+            getAppConfig().gerbil_energy_loss_factor, getAppConfig().gerbil_gestation_time )
+{
+    species_ = Species::GERBIL;
+}
 
 
-Gerbil::Gerbil(const Vec2d& position,const Vec2d& direction) : Animal(position
+Gerbil::Gerbil(const Vec2d& position,const Vec2d& direction) : SpeciesAnimal(position
     ,getAppConfig().gerbil_size,getAppConfig().gerbil_energy_initial
     ,uniform(0, 1) == 0,
             getAppConfig().gerbil_longevity,
-            getAppConfig().gerbil_energy_loss_factor, getAppConfig().gerbil_gestation_time,direction)   {}
+            getAppConfig().gerbil_energy_loss_factor, getAppConfig().gerbil_gestation_time,direction)
+{
+    species_ = Species::GERBIL;
+}
 
 Gerbil::Gerbil(const Vec2d& position,const Vec2d& direction, OrganicEntity* mum) :
-    Animal(position,
+    SpeciesAnimal(position,
            getAppConfig().gerbil_size,
            getAppConfig().gerbil_energy_initial,
            uniform(0, 1) == 0,
@@ -31,48 +39,15 @@ Gerbil::Gerbil(const Vec2d& position,const Vec2d& direction, OrganicEntity* mum)
            getAppConfig().gerbil_energy_loss_factor,
            getAppConfig().gerbil_gestation_time,direction, mum)
 {
+    species_ = Species::GERBIL;
 }
 
 Gerbil::Gerbil(const Vec2d& position, const double& energy,
                const bool& isFemale, const sf::Time& ageLimit =(sf::Time(getAppConfig().gerbil_longevity)
                                                                    )) :
-    Animal(position,getAppConfig().gerbil_size, energy, isFemale, ageLimit)
-{}
-
-const double& Gerbil::getStandardMaxSpeed() const
-{
-    return  getAppConfig().gerbil_max_speed;
-}
-
-const double& Gerbil::getMass() const
-{
-    return  getAppConfig().gerbil_mass;
-}
-
-const double& Gerbil::getViewRange() const
+    SpeciesAnimal(position,getAppConfig().gerbil_size, energy, isFemale, ageLimit)
 {
-    return getAppConfig().gerbil_view_range;
-}
-
-const double& Gerbil::getViewDistance()const
-{
-    return  getAppConfig().gerbil_view_distance;
-}
-
-const double& Gerbil::getRandomWalkRadius() const
-{
-    return getAppConfig().gerbil_random_walk_radius;
-}
-
-
-const double& Gerbil::getRandomWalkDistance() const
-{
-    return getAppConfig().gerbil_random_walk_distance;
-}
-
-const double& Gerbil::getRandomWalkJitter() const
-{
-    return getAppConfig().gerbil_random_walk_jitter;
+    species_ = Species::GERBIL;
 }
 
 const sf::Texture& Gerbil::getTexture() const
@@ -81,56 +56,12 @@ const sf::Texture& Gerbil::getTexture() const
                                     : getAppConfig().gerbil_texture_male);
 }
 
-bool Gerbil::eatable(OrganicEntity const* entity) const
-{
-
-    return entity->eatableBy(this);
-}
-
-bool Gerbil::eatableBy(Gerbil const*  ) const
-{
-    return false;
-}
-bool Gerbil::eatableBy(Food const*  ) const
-{
-    return false;
-}
-bool Gerbil::eatableBy(Scorpion const*  ) const
-{
-    return true;
-}
-
-bool Gerbil::matable(OrganicEntity const* entity   ) const
-{
-
-    return entity->canMate(this);
-}
-
-bool Gerbil::canMate(Gerbil const* G) const
-{
-    double minEnergy = isFemale() ? getAppConfig().gerbil_energy_min_mating_female
-                                  : getAppConfig().gerbil_energy_min_mating_male;
-    return getAge().asSeconds() >= getAppConfig().gerbil_min_age_mating
-        and getEnergy() >= minEnergy
-        and !isPregnant()
-        and isFemale() != G->isFemale();
-}
-
-bool Gerbil::canMate(Food const* ) const
-{
-    return false;
-}
-bool Gerbil::canMate(Scorpion const*  ) const
-{
-    return false;
-}
-
-void Gerbil::giveBirthThis()
+void Gerbil::giveBirthThis(Environment& env)
 {
     for (int i (0); i < getBabies(); ++i ) {
         OrganicEntity* mum(this);
         Gerbil* baby(new Gerbil(getPosition()-getDirection()*getRadius()*2.2, getDirection(), mum));
-        getAppEnv().addEntity(baby);
+        env.addEntity(baby);
         organic_entity_kids_.push_back(baby);
     }
     setBabies(0);
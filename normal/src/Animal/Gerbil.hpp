@@ -1,5 +1,5 @@
 #pragma once
-#include "Animal.hpp"
+#include "SpeciesAnimal.hpp"
 #include "../Utility/Vec2d.hpp"
 
 class Scorpion;
@@ -12,8 +12,11 @@ class Food;
  * The Gerbil class extends the Animal class and implements specific behaviors
  * for gerbils, including movement characteristics, interaction with other entities,
  * reproduction capabilities, and visual representation.
+ *
+ * Its parameters come from GerbilTraits, so that it is updated
+ * by the update kernel of its species (see SpeciesAnimal).
  */
-class Gerbil : public Animal
+class Gerbil : public SpeciesAnimal<GerbilTraits>
 {
 
 public:
@@ -90,128 +93,14 @@ public:
         return false;
     }
 
-    // Perception and movement characteristics
-    /**
-     * @brief Gets the viewing angle range for this gerbil
-     * 
-     * @return View range in radians
-     */
-    virtual const double& getViewRange() const override;
-    
-    /**
-     * @brief Gets the maximum viewing distance for this gerbil
-     * 
-     * @return View distance
-     */
-    virtual const double& getViewDistance() const override;
-    
-    /**
-     * @brief Gets the radius used for random walk behavior
-     * 
-     * @return Random walk radius
-     */
-    virtual const double& getRandomWalkRadius() const override;
-    
-    /**
-     * @brief Gets the distance parameter used for random walk behavior
-     * 
-     * @return Random walk distance
-     */
-    virtual const double& getRandomWalkDistance() const override;
-    
-    /**
-     * @brief Gets the maximum speed this gerbil can reach
-     * 
-     * @return Maximum speed
-     */
-    virtual const double& getStandardMaxSpeed() const override;
-    
-    /**
-     * @brief Gets the mass of this gerbil for force calculations
-     * 
-     * @return Mass value
-     */
-    virtual const double& getMass() const override;
-    
-    /**
-     * @brief Gets the jitter parameter used for random walk behavior
-     * 
-     * @return Random walk jitter value
-     */
-    virtual const double& getRandomWalkJitter() const override;
-
-    // Interaction with other entities
-    /**
-     * @brief Determines if this gerbil can be eaten by another gerbil
-     * 
-     * @param gerbil The potential predator
-     * @return true if eatable, false otherwise
-     */
-    bool eatableBy(Gerbil const* gerbil) const override;
-    
-    /**
-     * @brief Determines if this gerbil can be eaten by food
-     * 
-     * @param food The potential predator
-     * @return true if eatable, false otherwise
-     */
-    bool eatableBy(Food const* food) const override;
-    
-    /**
-     * @brief Determines if this gerbil can be eaten by a scorpion
-     * 
-     * @param scorpion The potential predator
-     * @return true if eatable, false otherwise
-     */
-    bool eatableBy(Scorpion const* scorpion) const override;
-    
-    /**
-     * @brief Determines if an entity can be eaten by this gerbil
-     * 
-     * @param entity The potential prey
-     * @return true if the entity is eatable, false otherwise
-     */
-    bool eatable(OrganicEntity const* entity) const override;
-
-    // Reproduction behaviors
-    /**
-     * @brief Determines if this gerbil can mate with another gerbil
-     * 
-     * @param gerbil The potential mate
-     * @return true if mating is possible, false otherwise
-     */
-    bool canMate(Gerbil const* gerbil) const override;
-    
-    /**
-     * @brief Determines if this gerbil can mate with food
-     * 
-     * @param food The potential mate
-     * @return true if mating is possible, false otherwise
-     */
-    bool canMate(Food const* food) const override;
-    
-    /**
-     * @brief Determines if this gerbil can mate with a scorpion
-     * 
-     * @param scorpion The potential mate
-     * @return true if mating is possible, false otherwise
-     */
-    bool canMate(Scorpion const* scorpion) const override;
-    
-    /**
-     * @brief Determines if an entity can mate with this gerbil
-     * 
-     * @param entity The potential mate
-     * @return true if mating is possible, false otherwise
-     */
-    bool matable(OrganicEntity const* entity) const override;
-
     /**
      * @brief Handles the birth process for this gerbil
      * 
      * Creates new baby gerbils and adds them to the environment
+     *
+     * @param env Environment receiving the babies
      */
-    void giveBirthThis() override;
+    void giveBirthThis(Environment& env) override;
     
     /**
      * @brief Gets the appropriate texture for rendering this gerbil
@@ -45,10 +45,10 @@ NeuronalScorpion::NeuronalScorpion(const Vec2d& position, const double& energy,
     neuronalScorpionAddSensors();
 }
 
-void NeuronalScorpion::update(sf::Time dt)
+void NeuronalScorpion::update(Environment& env, sf::Time dt)
 {
-    neuronalUpdateSensors(dt);
-    analyzeEnvironment();
+    neuronalUpdateSensors(env, dt);
+    analyzeEnvironment(env);
 
     OrganicEntity* closestEdible = getClosestEdible();
     if (closestEdible != nullptr) {
@@ -104,11 +104,11 @@ void NeuronalScorpion::UpdateState(sf::Time dt)
     }
 }
 
-void NeuronalScorpion::neuronalUpdateSensors(sf::Time dt)
+void NeuronalScorpion::neuronalUpdateSensors(Environment& env, sf::Time dt)
 {
     neuronalScorpionSetPositionOfSensors();
     for (auto& sen : neuronal_scorpion_vector_sensors_) {
-        sen.update(dt);
+        sen.update(env, dt);
     }
 }
 
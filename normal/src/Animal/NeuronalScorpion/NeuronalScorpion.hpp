@@ -59,7 +59,22 @@ public:
     NeuronalScorpion(const Vec2d&);
 
 
-    virtual void update(sf::Time ) override;
+    virtual void update(Environment&, sf::Time ) override;
+
+    /**
+    * @brief Nothing: the neuronal scorpion looks around in every update
+    */
+    void prepareUpdate(Environment&) override {}
+
+    /**
+    * @brief SERIAL_BUCKET: the neuronal scorpion has its own states, all
+    *        handled by update(), and moves itself at once rather than
+    *        through the steering batch, so it is not updated on a tile
+    */
+    UpdateBucket getUpdateBucket() const override
+    {
+        return SERIAL_BUCKET;
+    }
     void UpdateState(sf::Time dt);
 
 
@@ -113,7 +128,7 @@ public:
     * @brief Update the sensors of the scorpion
     *
     */
-    void neuronalUpdateSensors(sf::Time dt);
+    void neuronalUpdateSensors(Environment& env, sf::Time dt);
 
 
 protected:
@@ -14,9 +14,9 @@ Sensor::Sensor(const Vec2d& position, NeuronalScorpion* neuronalScorpion, const
     ,sensor_inhibitor_factor_(getAppConfig().sensor_inhibition_factor)
 {}
 
-void Sensor::update(sf::Time dt)
+void Sensor::update(Environment& env, sf::Time dt)
 {
-    sensorActivation();
+    sensorActivation(env);
     sensorUpdateScore();
     sensorInhibit();
 }
@@ -32,10 +32,10 @@ void Sensor::sensorTemper()
 
 }
 
-void Sensor::sensorActivation()
+void Sensor::sensorActivation(Environment& env)
 {
     if (sensor_active_==false) {
-        if 	( getAppEnv().envSensorActivationIntensityCumulated(this) >= sensor_intensity_threshold_) {
+        if 	( env.envSensorActivationIntensityCumulated(this) >= sensor_intensity_threshold_) {
             sensor_active_ = true;
 
 
@@ -1,10 +1,10 @@
 #pragma once
 #include "../../Obstacle/CircularCollider.hpp"
-#include "../../Interface/Updatable.hpp"
 #include "../../Interface/Drawable.hpp"
 #include "../../Environment/Wave.hpp"
 
 class NeuronalScorpion;
+class Environment;
 
 /**
  * @class Sensor
@@ -14,7 +14,7 @@ class NeuronalScorpion;
  * It can be activated by environmental factors, accumulate scores, and inhibit other sensors.
  */
 class Sensor
-    : public Updatable , public Drawable
+    : public Drawable
 {
 public:
     /**
@@ -34,9 +34,10 @@ public:
     /**
      * @brief Updates the sensor state
      * 
+     * @param env Environment carrying the waves the sensor listens to
      * @param dt Time elapsed since last update
      */
-    void update(sf::Time dt) override;
+    void update(Environment& env, sf::Time dt);
 
     /**
      * @brief Draws the sensor to the target window
@@ -54,8 +55,10 @@ public:
     
     /**
      * @brief Activates the sensor if intensity threshold is reached
+     *
+     * @param env Environment carrying the waves the sensor listens to
      */
-    void sensorActivation();
+    void sensorActivation(Environment& env);
 
     /**
      * @brief Increases the sensor's score
@@ -11,19 +11,19 @@ WaveGerbil::WaveGerbil(const Vec2d& position, const double& energy,
 WaveGerbil::WaveGerbil(const Vec2d& position,const Vec2d& direction, OrganicEntity* mum) : Gerbil(position,direction,mum),
     wave_gerbil_frequency_(sf::seconds(1.0/getAppConfig().wave_gerbil_frequency)),wave_gerbil_clock_(sf::Time::Zero) {}
 
-void WaveGerbil::update(sf::Time dt)
+void WaveGerbil::update(Environment& env, sf::Time dt)
 {
-    Animal::update(dt);
-    waveGerbilWaving(dt);
+    Gerbil::update(env, dt);
+    waveGerbilWaving(env, dt);
 }
 
-void WaveGerbil::waveGerbilWaving(sf::Time dt)
+void WaveGerbil::waveGerbilWaving(Environment& env, sf::Time dt)
 {
     if ( getState() != 7) {
         wave_gerbil_clock_ += dt;
         if (wave_gerbil_clock_ >= wave_gerbil_frequency_) {
             wave_gerbil_clock_= sf::Time::Zero;
-            getAppEnv().addWave(new Wave(this->getPosition(), getAppConfig().wave_default_energy, getAppConfig().wave_default_radius, getAppConfig().wave_default_mu, getAppConfig().wave_default_speed));
+            env.addWave(new Wave(this->getPosition(), getAppConfig().wave_default_energy, getAppConfig().wave_default_radius, getAppConfig().wave_default_mu, getAppConfig().wave_default_speed));
         }
     }
 }
\ No newline at end of file
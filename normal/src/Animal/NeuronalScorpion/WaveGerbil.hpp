@@ -58,9 +58,19 @@ public:
      * 
      * Extends the base Gerbil update by adding wave emission behavior
      * 
+     * @param env Environment the gerbil lives in
      * @param dt Time elapsed since last update
      */
-    virtual void update(sf::Time dt) override;
+    virtual void update(Environment& env, sf::Time dt) override;
+
+    /**
+     * @brief ACTIVE_BUCKET: the wave gerbil emits its waves in update(),
+     *        which wander() and hold() would skip
+     */
+    UpdateBucket getUpdateBucket() const override
+    {
+        return ACTIVE_BUCKET;
+    }
 
 protected:
     /**
@@ -68,9 +78,10 @@ protected:
      * 
      * Creates and emits waves at regular intervals based on the wave_gerbil_frequency_
      * 
+     * @param env Environment receiving the waves
      * @param dt Time elapsed since last update
      */
-    void waveGerbilWaving(sf::Time dt);
+    void waveGerbilWaving(Environment& env, sf::Time dt);
 
 private:
     sf::Time wave_gerbil_frequency_; ///< The time interval between wave emissions
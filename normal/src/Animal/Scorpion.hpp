@@ -1,5 +1,5 @@
 #pragma once
-#include "Animal.hpp"
+#include "SpeciesAnimal.hpp"
 #include "../Utility/Vec2d.hpp"
 
 class Food;
@@ -12,8 +12,11 @@ class Gerbil;
  * The Scorpion class extends the Animal class and implements specific behaviors
  * for scorpions, including movement characteristics, predatory interactions,
  * reproduction capabilities, and visual representation.
+ *
+ * Its parameters come from ScorpionTraits, so that it is updated
+ * by the update kernel of its species (see SpeciesAnimal).
  */
-class Scorpion : public Animal
+class Scorpion : public SpeciesAnimal<ScorpionTraits>
 {
 public:
     /**
@@ -71,63 +74,16 @@ public:
      * @brief Handles the birth process for this scorpion
      * 
      * Creates new baby scorpions and adds them to the environment
+     *
+     * @param env Environment receiving the babies
      */
-    void giveBirthThis() override;
+    void giveBirthThis(Environment& env) override;
 
     /**
      * @brief Destructor for Scorpion
      */
     ~Scorpion() {}
 
-    // Perception and movement characteristics
-    /**
-     * @brief Gets the viewing angle range for this scorpion
-     * 
-     * @return View range in radians
-     */
-    virtual const double& getViewRange() const override;
-    
-    /**
-     * @brief Gets the maximum viewing distance for this scorpion
-     * 
-     * @return View distance
-     */
-    virtual const double& getViewDistance() const override;
-    
-    /**
-     * @brief Gets the radius used for random walk behavior
-     * 
-     * @return Random walk radius
-     */
-    virtual const double& getRandomWalkRadius() const override;
-    
-    /**
-     * @brief Gets the distance parameter used for random walk behavior
-     * 
-     * @return Random walk distance
-     */
-    virtual const double& getRandomWalkDistance() const override;
-    
-    /**
-     * @brief Gets the maximum speed this scorpion can reach
-     * 
-     * @return Maximum speed
-     */
-    virtual const double& getStandardMaxSpeed() const override;
-    
-    /**
-     * @brief Gets the mass of this scorpion for force calculations
-     * 
-     * @return Mass value
-     */
-    virtual const double& getMass() const override;
-    
-    /**
-     * @brief Gets the jitter parameter used for random walk behavior
-     * 
-     * @return Random walk jitter value
-     */
-    virtual const double& getRandomWalkJitter() const override;
     
     /**
      * @brief Gets the appropriate texture for rendering this scorpion
@@ -136,72 +92,6 @@ public:
      */
     virtual const sf::Texture& getTexture() const override;
 
-    // Predation interactions
-    /**
-     * @brief Determines if this scorpion can be eaten by a gerbil
-     * 
-     * @param gerbil The potential predator
-     * @return true if eatable, false otherwise
-     */
-    bool eatableBy(Gerbil const* gerbil) const override;
-    
-    /**
-     * @brief Determines if this scorpion can be eaten by food
-     * 
-     * @param food The potential predator
-     * @return true if eatable, false otherwise
-     */
-    bool eatableBy(Food const* food) const override;
-    
-    /**
-     * @brief Determines if this scorpion can be eaten by another scorpion
-     * 
-     * @param scorpion The potential predator
-     * @return true if eatable, false otherwise
-     */
-    bool eatableBy(Scorpion const* scorpion) const override;
-    
-    /**
-     * @brief Determines if an entity can be eaten by this scorpion
-     * 
-     * @param entity The potential prey
-     * @return true if the entity is eatable, false otherwise
-     */
-    bool eatable(OrganicEntity const* entity) const override;
-
-    // Reproduction behaviors
-    /**
-     * @brief Determines if this scorpion can mate with a gerbil
-     * 
-     * @param gerbil The potential mate
-     * @return true if mating is possible, false otherwise
-     */
-    bool canMate(Gerbil const* gerbil) const override;
-    
-    /**
-     * @brief Determines if this scorpion can mate with food
-     * 
-     * @param food The potential mate
-     * @return true if mating is possible, false otherwise
-     */
-    bool canMate(Food const* food) const override;
-    
-    /**
-     * @brief Determines if this scorpion can mate with another scorpion
-     * 
-     * @param scorpion The potential mate
-     * @return true if mating is possible, false otherwise
-     */
-    bool canMate(Scorpion const* scorpion) const override;
-    
-    /**
-     * @brief Determines if an entity can mate with this scorpion
-     * 
-     * @param entity The potential mate
-     * @return true if mating is possible, false otherwise
-     */
-    bool matable(OrganicEntity const* entity) const override;
-
     // Entity type identification
     /**
      * @brief Checks if this entity is a Gerbil
@@ -0,0 +1,124 @@
+#pragma once
+#include "Animal.hpp"
+#include "../Application.hpp"
+
+/**
+ * @brief Parameters of the gerbils, as read by the update kernel
+ *
+ * A traits struct gives, for one species, every value Animal's update
+ * kernel would otherwise fetch through a virtual getter. The functions take
+ * the animal so that Animal::VirtualTraits can have the same interface.
+ */
+struct GerbilTraits
+{
+    static const double& viewRange(Animal const&)          { return getAppConfig().gerbil_view_range; }
+    static const double& viewDistance(Animal const&)       { return getAppConfig().gerbil_view_distance; }
+    static const double& randomWalkRadius(Animal const&)   { return getAppConfig().gerbil_random_walk_radius; }
+    static const double& randomWalkDistance(Animal const&) { return getAppConfig().gerbil_random_walk_distance; }
+    static const double& randomWalkJitter(Animal const&)   { return getAppConfig().gerbil_random_walk_jitter; }
+    static const double& standardMaxSpeed(Animal const&)   { return getAppConfig().gerbil_max_speed; }
+    static const double& mass(Animal const&)               { return getAppConfig().gerbil_mass; }
+    static const double& perceptionPeriod(Animal const&)   { return getAppConfig().gerbil_perception_period; }
+};
+
+/**
+ * @brief Parameters of the scorpions, as read by the update kernel
+ */
+struct ScorpionTraits
+{
+    static const double& viewRange(Animal const&)          { return getAppConfig().scorpion_view_range; }
+    static const double& viewDistance(Animal const&)       { return getAppConfig().scorpion_view_distance; }
+    static const double& randomWalkRadius(Animal const&)   { return getAppConfig().scorpion_random_walk_radius; }
+    static const double& randomWalkDistance(Animal const&) { return getAppConfig().scorpion_random_walk_distance; }
+    static const double& randomWalkJitter(Animal const&)   { return getAppConfig().scorpion_random_walk_jitter; }
+    static const double& standardMaxSpeed(Animal const&)   { return getAppConfig().scorpion_max_speed; }
+    static const double& mass(Animal const&)               { return getAppConfig().scorpion_mass; }
+    static const double& perceptionPeriod(Animal const&)   { return getAppConfig().scorpion_perception_period; }
+};
+
+/**
+ * @class SpeciesAnimal
+ * @brief Animal whose parameters are known at compile time
+ *
+ * Implements the parameter getters of Animal from a traits struct and
+ * updates with the kernel instantiated for those traits, in which every
+ * parameter read and every steering helper is a direct, inlinable call.
+ * Gerbil and Scorpion derive from it; the Animal interface is unchanged.
+ *
+ * The kernels are explicitly instantiated in Animal.cpp for the traits
+ * declared here: a new species adds its traits there too.
+ *
+ * @tparam Traits Struct shaped like GerbilTraits
+ */
+template <class Traits>
+class SpeciesAnimal : public Animal
+{
+public:
+    using Animal::Animal;
+
+    const double& getViewRange() const override
+    {
+        return Traits::viewRange(*this);
+    }
+
+    const double& getViewDistance() const override
+    {
+        return Traits::viewDistance(*this);
+    }
+
+    const double& getRandomWalkRadius() const override
+    {
+        return Traits::randomWalkRadius(*this);
+    }
+
+    const double& getRandomWalkDistance() const override
+    {
+        return Traits::randomWalkDistance(*this);
+    }
+
+    const double& getStandardMaxSpeed() const override
+    {
+        return Traits::standardMaxSpeed(*this);
+    }
+
+    const double& getMass() const override
+    {
+        return Traits::mass(*this);
+    }
+
+    const double& getRandomWalkJitter() const override
+    {
+        return Traits::randomWalkJitter(*this);
+    }
+
+    double getPerceptionPeriod() const override
+    {
+        return Traits::perceptionPeriod(*this);
+    }
+
+protected:
+    /**
+     * @brief Updates the animal with the kernel of its species
+     * @param env Environment the animal lives in
+     * @param dt Time elapsed since last update
+     */
+    void update(Environment& env, sf::Time dt) override
+    {
+        updateKernel<Traits>(env, dt);
+    }
+
+    /**
+     * @brief Wanders with the kernel of its species
+     * @param env Environment the animal lives in
+     * @param dt Time elapsed since last update
+     */
+    void wander(Environment& env, sf::Time dt) override
+    {
+        wanderKernel<Traits>(env, dt);
+    }
+};
+
+extern template void Animal::updateKernel<GerbilTraits>(Environment&, sf::Time);
+extern template void Animal::updateKernel<ScorpionTraits>(Environment&, sf::Time);
+extern template void Animal::wanderKernel<GerbilTraits>(Environment&, sf::Time);
+extern template void Animal::wanderKernel<ScorpionTraits>(Environment&, sf::Time);
@@ -0,0 +1,254 @@
+#include "SteeringBatch.hpp"
+#include "../Utility/Constants.hpp"
+
+#include <cmath>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+
+/// clamping() of CircularCollider.cpp
+inline double wrap(double v, double size)
+{
+    double result(v);
+    if (v < 0) result += size;
+    if (v > size) result -= size;
+    return result;
+}
+
+/// Shift of the torus copy of a target CircularCollider::directionTo picks
+inline double shift(double delta, double size)
+{
+    return delta >= size / 2 ? -size : (delta < -size / 2 ? size : 0.0);
+}
+
+} // anonymous
+
+SteeringBatch::SteeringBatch()
+    : open_(false)
+{
+}
+
+void SteeringBatch::open()
+{
+    open_ = true;
+}
+
+void SteeringBatch::close()
+{
+    open_ = false;
+}
+
+bool SteeringBatch::isOpen() const
+{
+    return open_;
+}
+
+void SteeringBatch::seek(Animal* owner, Vec2d const& position, Vec2d const& direction, double speed,
+                         double maxSpeed, double mass, Vec2d const& target)
+{
+    add(owner, position, direction, speed, maxSpeed, mass, target, true);
+}
+
+void SteeringBatch::push(Animal* owner, Vec2d const& position, Vec2d const& direction, double speed,
+                         double maxSpeed, double mass, Vec2d const& force)
+{
+    add(owner, position, direction, speed, maxSpeed, mass, force, false);
+}
+
+void SteeringBatch::add(Animal* owner, Vec2d const& position, Vec2d const& direction, double speed,
+                        double maxSpeed, double mass, Vec2d const& steering, bool seek)
+{
+    owners_.push_back(owner);
+    x_.push_back(position.x);
+    y_.push_back(position.y);
+    direction_x_.push_back(direction.x);
+    direction_y_.push_back(direction.y);
+    speed_.push_back(speed);
+    max_speed_.push_back(maxSpeed);
+    mass_.push_back(mass);
+    steering_x_.push_back(steering.x);
+    steering_y_.push_back(steering.y);
+    seek_.push_back(seek ? 1.0 : 0.0);
+}
+
+void SteeringBatch::clear()
+{
+    owners_.clear();
+    x_.clear();
+    y_.clear();
+    direction_x_.clear();
+    direction_y_.clear();
+    speed_.clear();
+    max_speed_.clear();
+    mass_.clear();
+    steering_x_.clear();
+    steering_y_.clear();
+    seek_.clear();
+}
+
+std::size_t SteeringBatch::size() const
+{
+    return owners_.size();
+}
+
+Animal* SteeringBatch::getOwner(std::size_t i) const
+{
+    return owners_[i];
+}
+
+Vec2d SteeringBatch::getPosition(std::size_t i) const
+{
+    return Vec2d(x_[i], y_[i]);
+}
+
+Vec2d SteeringBatch::getDirection(std::size_t i) const
+{
+    return Vec2d(direction_x_[i], direction_y_[i]);
+}
+
+double SteeringBatch::getSpeed(std::size_t i) const
+{
+    return speed_[i];
+}
+
+void SteeringBatch::integrateOne(std::size_t i, double deltaT, double worldSize)
+{
+    double const x(x_[i]);
+    double const y(y_[i]);
+    double const hx(direction_x_[i]);
+    double const hy(direction_y_[i]);
+    double const speed(speed_[i]);
+    double const maxSpeed(max_speed_[i]);
+
+    // Animal::force()
+    double fx(steering_x_[i]);
+    double fy(steering_y_[i]);
+    if (seek_[i] != 0) {
+        double const tx(wrap(fx, worldSize));
+        double const ty(wrap(fy, worldSize));
+        double const ex((tx + shift(tx - x, worldSize)) - x);
+        double const ey((ty + shift(ty - y, worldSize)) - y);
+        double const length(std::sqrt(ex * ex + ey * ey));
+        if (std::abs(length) < EPSILON) {
+            fx = hx;
+            fy = hy;
+        } else {
+            double const brake(length / ANIMAL_DECELERATION);
+            double const wanted(brake <= maxSpeed ? brake : maxSpeed);
+            fx = ex / length * wanted - speed * hx;
+            fy = ey / length * wanted - speed * hy;
+        }
+    }
+
+    // Animal::moveToVec2dForce()
+    double vx(speed * hx + fx / mass_[i] * deltaT);
+    double vy(speed * hy + fy / mass_[i] * deltaT);
+    double const v(std::sqrt(vx * vx + vy * vy));
+    double nx(vx);
+    double ny(vy);
+    if (!(std::abs(v) < EPSILON)) {
+        nx = vx / v;
+        ny = vy / v;
+    }
+    if (v > maxSpeed) {
+        vx = nx * maxSpeed;
+        vy = ny * maxSpeed;
+    }
+    x_[i] = wrap(x + vx * deltaT, worldSize);
+    y_[i] = wrap(y + vy * deltaT, worldSize);
+    direction_x_[i] = nx;
+    direction_y_[i] = ny;
+    speed_[i] = std::sqrt(vx * vx + vy * vy);
+}
+
+#ifdef __SSE2__
+
+void SteeringBatch::integrate(double deltaT, double worldSize)
+{
+    __m128d const zero(_mm_setzero_pd());
+    __m128d const sign(_mm_set1_pd(-0.0));
+    __m128d const epsilon(_mm_set1_pd(EPSILON));
+    __m128d const deceleration(_mm_set1_pd(ANIMAL_DECELERATION));
+    __m128d const dt(_mm_set1_pd(deltaT));
+    __m128d const world(_mm_set1_pd(worldSize));
+    __m128d const half(_mm_set1_pd(worldSize / 2));
+    __m128d const minusHalf(_mm_set1_pd(-(worldSize / 2)));
+
+    // mask ? a : b
+    auto blend = [](__m128d mask, __m128d a, __m128d b) {
+        return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+    };
+    auto wrapLanes = [&](__m128d v) {
+        __m128d const low(_mm_and_pd(_mm_cmplt_pd(v, zero), world));
+        __m128d const high(_mm_and_pd(_mm_cmpgt_pd(v, world), world));
+        return _mm_sub_pd(_mm_add_pd(v, low), high);
+    };
+    auto shiftLanes = [&](__m128d delta) {
+        __m128d const up(_mm_and_pd(_mm_cmplt_pd(delta, minusHalf), world));
+        return blend(_mm_cmpge_pd(delta, half), _mm_sub_pd(zero, world), up);
+    };
+
+    std::size_t const count(size());
+    std::size_t i(0);
+    for (; i + 1 < count; i += 2) {
+        __m128d const x(_mm_loadu_pd(&x_[i]));
+        __m128d const y(_mm_loadu_pd(&y_[i]));
+        __m128d const hx(_mm_loadu_pd(&direction_x_[i]));
+        __m128d const hy(_mm_loadu_pd(&direction_y_[i]));
+        __m128d const speed(_mm_loadu_pd(&speed_[i]));
+        __m128d const maxSpeed(_mm_loadu_pd(&max_speed_[i]));
+        __m128d const mass(_mm_loadu_pd(&mass_[i]));
+        __m128d const sx(_mm_loadu_pd(&steering_x_[i]));
+        __m128d const sy(_mm_loadu_pd(&steering_y_[i]));
+        __m128d const seeking(_mm_cmpneq_pd(_mm_loadu_pd(&seek_[i]), zero));
+
+        // Animal::force()
+        __m128d const tx(wrapLanes(sx));
+        __m128d const ty(wrapLanes(sy));
+        __m128d const ex(_mm_sub_pd(_mm_add_pd(tx, shiftLanes(_mm_sub_pd(tx, x))), x));
+        __m128d const ey(_mm_sub_pd(_mm_add_pd(ty, shiftLanes(_mm_sub_pd(ty, y))), y));
+        __m128d const length(_mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(ex, ex), _mm_mul_pd(ey, ey))));
+        __m128d const reached(_mm_cmplt_pd(_mm_andnot_pd(sign, length), epsilon));
+        __m128d const brake(_mm_div_pd(length, deceleration));
+        __m128d const wanted(blend(_mm_cmple_pd(brake, maxSpeed), brake, maxSpeed));
+        __m128d const seekX(_mm_sub_pd(_mm_mul_pd(_mm_div_pd(ex, length), wanted), _mm_mul_pd(speed, hx)));
+        __m128d const seekY(_mm_sub_pd(_mm_mul_pd(_mm_div_pd(ey, length), wanted), _mm_mul_pd(speed, hy)));
+        __m128d const fx(blend(seeking, blend(reached, hx, seekX), sx));
+        __m128d const fy(blend(seeking, blend(reached, hy, seekY), sy));
+
+        // Animal::moveToVec2dForce()
+        __m128d vx(_mm_add_pd(_mm_mul_pd(speed, hx), _mm_mul_pd(_mm_div_pd(fx, mass), dt)));
+        __m128d vy(_mm_add_pd(_mm_mul_pd(speed, hy), _mm_mul_pd(_mm_div_pd(fy, mass), dt)));
+        __m128d const v(_mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(vx, vx), _mm_mul_pd(vy, vy))));
+        __m128d const still(_mm_cmplt_pd(_mm_andnot_pd(sign, v), epsilon));
+        __m128d const nx(blend(still, vx, _mm_div_pd(vx, v)));
+        __m128d const ny(blend(still, vy, _mm_div_pd(vy, v)));
+        __m128d const tooFast(_mm_cmpgt_pd(v, maxSpeed));
+        vx = blend(tooFast, _mm_mul_pd(nx, maxSpeed), vx);
+        vy = blend(tooFast, _mm_mul_pd(ny, maxSpeed), vy);
+
+        _mm_storeu_pd(&x_[i], wrapLanes(_mm_add_pd(x, _mm_mul_pd(vx, dt))));
+        _mm_storeu_pd(&y_[i], wrapLanes(_mm_add_pd(y, _mm_mul_pd(vy, dt))));
+        _mm_storeu_pd(&direction_x_[i], nx);
+        _mm_storeu_pd(&direction_y_[i], ny);
+        _mm_storeu_pd(&speed_[i], _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(vx, vx), _mm_mul_pd(vy, vy))));
+    }
+    if (i < count) {
+        integrateOne(i, deltaT, worldSize);
+    }
+}
+
+#else
+
+void SteeringBatch::integrate(double deltaT, double worldSize)
+{
+    for (std::size_t i(0); i < size(); ++i) {
+        integrateOne(i, deltaT, worldSize);
+    }
+}
+
+#endif
@@ -0,0 +1,94 @@
+#include "ViewCone.hpp"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+ViewCone::ViewCone()
+    : ViewCone(Vec2d(0, 0), Vec2d(0, 0), 1.0, -1.0)
+{
+}
+
+ViewCone::ViewCone(Vec2d const& origin, Vec2d const& heading, double cosHalfAngle, double distance)
+    : origin_x_(origin.x)
+    , origin_y_(origin.y)
+    , heading_x_(heading.x)
+    , heading_y_(heading.y)
+    , cos_half_(cosHalfAngle)
+    , cos_half_sq_(cosHalfAngle * cosHalfAngle)
+    , distance_sq_(distance < 0 ? -1.0 : distance * distance)
+{
+}
+
+bool ViewCone::contains(Vec2d const& point) const
+{
+    std::uint32_t index;
+    return select(&point.x, &point.y, 1, &index) == 1;
+}
+
+#ifdef __SSE2__
+
+std::size_t ViewCone::select(double const* xs, double const* ys, std::size_t count,
+                             std::uint32_t* selected) const
+{
+    __m128d const ox(_mm_set1_pd(origin_x_));
+    __m128d const oy(_mm_set1_pd(origin_y_));
+    __m128d const hx(_mm_set1_pd(heading_x_));
+    __m128d const hy(_mm_set1_pd(heading_y_));
+    __m128d const cc(_mm_set1_pd(cos_half_sq_));
+    __m128d const l2(_mm_set1_pd(distance_sq_));
+    __m128d const zero(_mm_setzero_pd());
+    bool const narrow(cos_half_ >= 0); // view range of at most 180 degrees
+
+    // Two positions per iteration; lane 0 holds position i, lane 1 i + 1
+    auto lanes = [&](__m128d x, __m128d y) {
+        __m128d const dx(_mm_sub_pd(x, ox));
+        __m128d const dy(_mm_sub_pd(y, oy));
+        __m128d const d2(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)));
+        __m128d const dot(_mm_add_pd(_mm_mul_pd(hx, dx), _mm_mul_pd(hy, dy)));
+        __m128d const dot2(_mm_mul_pd(dot, dot));
+        __m128d const limit(_mm_mul_pd(cc, d2));
+        __m128d const ahead(_mm_cmpge_pd(dot, zero));
+        __m128d const cone(narrow
+                           ? _mm_and_pd(ahead, _mm_cmpge_pd(dot2, limit))
+                           : _mm_or_pd(ahead, _mm_cmple_pd(dot2, limit)));
+        return _mm_movemask_pd(_mm_and_pd(_mm_cmple_pd(d2, l2), cone));
+    };
+
+    std::size_t n(0);
+    std::size_t i(0);
+    for (; i + 1 < count; i += 2) {
+        int const mask(lanes(_mm_loadu_pd(xs + i), _mm_loadu_pd(ys + i)));
+        if (mask & 1) selected[n++] = i;
+        if (mask & 2) selected[n++] = i + 1;
+    }
+    if (i < count) {
+        // odd tail: same lanes, the second one being a copy of the first
+        if (lanes(_mm_set1_pd(xs[i]), _mm_set1_pd(ys[i])) & 1) selected[n++] = i;
+    }
+    return n;
+}
+
+#else
+
+std::size_t ViewCone::select(double const* xs, double const* ys, std::size_t count,
+                             std::uint32_t* selected) const
+{
+    bool const narrow(cos_half_ >= 0); // view range of at most 180 degrees
+
+    std::size_t n(0);
+    for (std::size_t i(0); i < count; ++i) {
+        double const dx(xs[i] - origin_x_);
+        double const dy(ys[i] - origin_y_);
+        double const d2(dx * dx + dy * dy);
+        double const dot(heading_x_ * dx + heading_y_ * dy);
+        double const dot2(dot * dot);
+        double const limit(cos_half_sq_ * d2);
+        bool const ahead(dot >= 0);
+        bool const cone(narrow ? ahead and dot2 >= limit : ahead or dot2 <= limit);
+        if (d2 <= distance_sq_ and cone) selected[n++] = i;
+    }
+    return n;
+}
+
+#endif
@@ -0,0 +1,72 @@
+#pragma once
+#include "../Utility/Vec2d.hpp"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class ViewCone
+ * @brief An animal's field of view, prepared for trig- and sqrt-free tests
+ *
+ * A point p is seen from apex o, heading h, half view angle a and view
+ * distance l when, with d = p - o:
+ *   - d.d <= l*l
+ *   - h.d >= cos(a) * |d|
+ *
+ * The angular test is evaluated on squares ((h.d)^2 against cos(a)^2 d.d,
+ * the sign of h.d being checked apart), so once the cone is built no
+ * cosine nor square root is needed per tested point. As in the original
+ * Animal::isTargetInSight, distances are not wrapped around the torus.
+ *
+ * select() tests a whole batch of positions two at a time in SSE2 lanes
+ * (with a plain C++ fallback when SSE2 is not available). contains() goes
+ * through the very same code, so a single test and a batched one always
+ * agree bit for bit.
+ */
+class ViewCone
+{
+public:
+    /**
+     * @brief Builds an empty cone (sees nothing)
+     */
+    ViewCone();
+
+    /**
+     * @brief Builds a cone
+     *
+     * @param origin apex of the cone (the animal's position)
+     * @param heading axis of the cone (the animal's direction)
+     * @param cosHalfAngle cosine of half the view range
+     * @param distance view distance
+     */
+    ViewCone(Vec2d const& origin, Vec2d const& heading, double cosHalfAngle, double distance);
+
+    /**
+     * @brief Tests a single position
+     *
+     * @param point position to test
+     * @return true if the point is in the cone
+     */
+    bool contains(Vec2d const& point) const;
+
+    /**
+     * @brief Tests a batch of positions
+     *
+     * @param xs x coordinates of the positions
+     * @param ys y coordinates of the positions
+     * @param count number of positions
+     * @param selected receives the indices (in increasing order) of the
+     *        positions in the cone; must have room for count indices
+     * @return number of indices written to selected
+     */
+    std::size_t select(double const* xs, double const* ys, std::size_t count,
+                       std::uint32_t* selected) const;
+
+private:
+    double origin_x_;
+    double origin_y_;
+    double heading_x_;
+    double heading_y_;
+    double cos_half_;    ///< cosine of the half view angle
+    double cos_half_sq_; ///< its square
+    double distance_sq_; ///< squared view distance
+};
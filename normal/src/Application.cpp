@@ -8,6 +8,7 @@
 #include "Config.hpp"
 #include <JSON/JSONSerialiser.hpp>
 #include <Utility/Constants.hpp>
+#include <Utility/Profiler.hpp>
 #include <iomanip> // setprecision
 #include <sstream> // stringstream
 
@@ -19,6 +20,11 @@ namespace // anonymous
 
 Application* currentApp = nullptr; ///< Current application
 
+thread_local Config*      boundConfig = nullptr; ///< Config bound to this thread, if any
+thread_local Environment* boundEnv    = nullptr; ///< Env bound to this thread, if any
+
+std::uint64_t const TRACE_TICKS = 600; ///< ticks written by writeTrace(), ~10s at 60 FPS
+
 std::string applicationDirectory(int argc, char const** argv)
 {
     assert(argc >= 1);
@@ -146,6 +152,9 @@ Application::Application(int argc, char const** argv)
     , mEnvNeuronal(nullptr)
     , mStats(nullptr)
     , mPaused(false)
+    , mTurbo(false)
+    , mTickRate(0)
+    , mSpeed(0)
     , mIsResetting(false)
     , mIsSwitchingView(false)
     , mIsDragging(false)
@@ -224,12 +233,44 @@ void Application::run()
     sf::Clock fpsClk;
     int frameCount = 0;
     int nbCycles = 10;
+
+    // Ticks per second, and simulated time per second
+    sf::Clock tickRateClk;
+    int tickCount = 0;
+    sf::Time simulatedTime = sf::Time::Zero;
+
+    // Turbo periods: from the end of a drawing to the end of the next one
+    sf::Clock turboClk;
+    sf::Time drawCost = sf::Time::Zero; // last render and display()
+
+    // One tick of the simulation
+    auto step = [&](sf::Time dt) {
+        getEnv().update(dt);
+        if (getAppConfig().simulation_time_background_update) {
+            // the world that isn't shown keeps living too
+            (&getEnv() == mEnvPPS ? mEnvNeuronal : mEnvPPS)->update(dt);
+        }
+        {
+            ScopedTimer timer(Phase::Stats);
+            getStats().update(dt);
+        }
+        onUpdate(dt);
+        ++tickCount;
+        simulatedTime += dt;
+    };
+
     // Main loop
     while (mRenderWindow.isOpen()) {
+        Profiler::forThisThread().beginTick();
+        sf::Clock frameClk; // cost of the frame, without the wait in display()
+
         // Handle events
-        sf::Event event;
-        while (mRenderWindow.pollEvent(event)) {
-            handleEvent(event, mRenderWindow);
+        {
+            ScopedTimer timer(Phase::Events);
+            sf::Event event;
+            while (mRenderWindow.pollEvent(event)) {
+                handleEvent(event, mRenderWindow);
+            }
         }
 
 
@@ -238,7 +279,25 @@ void Application::run()
         float timeFactor = getAppConfig().simulation_time_factor;
         auto elapsedTime = clk.restart() * timeFactor; // Always reset the clock!
 
-        if (!mPaused && !mIsResetting) {
+        bool const turbo(!mPaused && !mIsResetting && mTurbo);
+        if (turbo) {
+            // Fast forward: ticks of max dt, whatever the time elapsed,
+            // until what is left of the render period is the time the last
+            // drawing took, then one drawing. The whole period, events and
+            // drawing included, is measured. Stepping takes at least its
+            // share of the period, even when drawing takes longer than the
+            // rest. The governor is off, the simulation runs in full.
+            sf::Time const maxDt = getAppConfig().simulation_time_max_dt;
+            sf::Time const period = getAppConfig().simulation_time_turbo_render_period;
+            sf::Time const stepping = std::max(period - drawCost,
+                                               period * static_cast<float>(getAppConfig().simulation_time_turbo_stepping_fraction));
+            mGovernor.setBudget(sf::Time::Zero);
+            mEnvPPS->setQuality(mGovernor.getQuality());
+            mEnvNeuronal->setQuality(mGovernor.getQuality());
+            do {
+                step(maxDt);
+            } while (turboClk.getElapsedTime() < stepping);
+        } else if (!mPaused && !mIsResetting) {
             // Update simulation with the elapsed time, possibly
             // by calling update(dt) several time to avoid update
             // with high delta time.
@@ -246,23 +305,47 @@ void Application::run()
             // An alternative implementation could be based on fixed
             // timesteps.
             sf::Time maxDt = getAppConfig().simulation_time_max_dt;
-            while (elapsedTime > sf::Time::Zero) {
+            mGovernor.setBudget(getAppConfig().simulation_time_frame_budget);
+            mEnvPPS->setQuality(mGovernor.getQuality());
+            mEnvNeuronal->setQuality(mGovernor.getQuality());
+            while (elapsedTime > sf::Time::Zero and mGovernor.canCatchUp(frameClk.getElapsedTime())) {
                 auto dt = std::min(elapsedTime, maxDt);
                 elapsedTime -= dt;
-                getEnv().update(dt);
-                getStats().update(dt);
-                onUpdate(dt);
+                step(dt);
                 --nbCycles;
 
             }
         }
-        // Render everything
-        render(mSimulationBackground, statsBackground, controlBackground);
-        ++frameCount;
+        // Render everything, only one frame in a few under heavy load
+        bool const drawn(mGovernor.isDrawnFrame() or mPaused or mTurbo);
+        sf::Clock drawClk;
+        if (drawn) {
+            ScopedTimer timer(Phase::Draw);
+            render(mSimulationBackground, statsBackground, controlBackground);
+        }
+        if (!mPaused and !mTurbo) {
+            mGovernor.record(frameClk.getElapsedTime());
+        }
+        if (drawn) {
+            mRenderWindow.display();
+            ++frameCount;
+        }
+        if (turbo) {
+            drawCost = drawClk.getElapsedTime();
+        }
+        turboClk.restart();
 
         // In case we were resetting the simulation
         mIsResetting = false;
 
+        if (tickRateClk.getElapsedTime() > sf::milliseconds(500)) {
+            auto const wall = tickRateClk.restart().asSeconds();
+            mTickRate = tickCount / wall;
+            mSpeed = simulatedTime.asSeconds() / wall;
+            tickCount = 0;
+            simulatedTime = sf::Time::Zero;
+        }
+
         // FPS computation
         //++frameCount;
         if (fpsClk.getElapsedTime() > sf::seconds(2)) {
@@ -465,6 +548,11 @@ void Application::handleEvent(sf::Event event, sf::RenderWindow& window)
             mPaused = !mPaused;
             break;
 
+        // Toggle fast forward
+        case sf::Keyboard::T:
+            mTurbo = !mTurbo;
+            break;
+
         // Reset the simulation
         case sf::Keyboard::R:
             getEnv().clean();
@@ -475,6 +563,11 @@ void Application::handleEvent(sf::Event event, sf::RenderWindow& window)
             // TODO add TAB binding for switching from graphs
             break;
 
+        // Dump the timings of the last ticks
+        case sf::Keyboard::P:
+            writeTrace();
+            break;
+
         // Reset the simulation
         case sf::Keyboard::Right:
             mSimulationView.move(100, 0);
@@ -601,9 +694,6 @@ void Application::render(sf::Drawable const& simulationBackground, sf::Drawable
     mRenderWindow.draw(statsBackground);
     getStats().draw(mRenderWindow);
 
-    // Finally, publish everything onto the screen
-    mRenderWindow.display();
-
     // Reconfigure the window to use the simulation view
     // so that handling event (zoom + move) is easier
     mRenderWindow.setView(mSimulationView);
@@ -735,6 +825,10 @@ Application& getApp()
 
 Environment& getAppEnv()
 {
+    if (boundEnv != nullptr) {
+        return *boundEnv;
+    }
+
     return getApp().getEnv();
 }
 
@@ -746,6 +840,10 @@ Environment& getAppEnv()
 
 Config& getAppConfig()
 {
+    if (boundConfig != nullptr) {
+        return *boundConfig;
+    }
+
     return getApp().getConfig();
 }
 
@@ -765,6 +863,40 @@ bool isDebugOn()
     return getAppConfig().getDebug();
 }
 
+WorldBinding::WorldBinding(Config& config)
+    : mPreviousConfig(boundConfig)
+    , mPreviousEnv(boundEnv)
+{
+    boundConfig = &config;
+}
+
+WorldBinding::WorldBinding(Config& config, Environment& env)
+    : WorldBinding(config)
+{
+    boundEnv = &env;
+}
+
+WorldBinding::~WorldBinding()
+{
+    boundConfig = mPreviousConfig;
+    boundEnv = mPreviousEnv;
+}
+
+
+void Application::writeTrace() const
+{
+    auto const& profiler(Profiler::forThisThread());
+    auto const last(profiler.getTick());
+    auto const first(last > TRACE_TICKS ? last - TRACE_TICKS + 1 : 0);
+    auto const path(mAppDirectory + "trace.json");
+    try {
+        auto const count(profiler.writeTrace(path, first, last));
+        std::cout << "Wrote " << count << " timings of ticks " << first << " to " << last
+                  << " to " << path << std::endl;
+    } catch (std::runtime_error const& error) {
+        std::cerr << error.what() << std::endl;
+    }
+}
 
 void Application::drawControls(sf::RenderWindow& target)
 {
@@ -773,6 +905,45 @@ void Application::drawControls(sf::RenderWindow& target)
     auto const FONT_SIZE = 20;
     drawTitle(target, sf::Color::White, LEGEND_MARGIN, lastLegendY, FONT_SIZE);
     lastLegendY += FONT_SIZE + 4;
+
+    // Recent cost of each phase of a tick
+    auto const TIMING_FONT_SIZE = 14;
+    auto const& profiler(Profiler::forThisThread());
+    lastLegendY += TIMING_FONT_SIZE;
+    drawText(target, "p50 / p99 (ms)", sf::Color::White, LEGEND_MARGIN, lastLegendY, TIMING_FONT_SIZE);
+    lastLegendY += TIMING_FONT_SIZE + 4;
+    for (std::size_t p(0); p < PHASE_COUNT; ++p) {
+        auto const phase(static_cast<Phase>(p));
+        std::stringstream line;
+        line << std::fixed << std::setprecision(2)
+             << Profiler::phaseName(phase) << " : "
+             << profiler.percentile(phase, 0.5) << " / " << profiler.percentile(phase, 0.99);
+        drawText(target, line.str(), sf::Color::White, LEGEND_MARGIN, lastLegendY, TIMING_FONT_SIZE);
+        lastLegendY += TIMING_FONT_SIZE + 4;
+    }
+
+    // Pace of the simulation
+    {
+        std::stringstream line;
+        line << std::fixed << std::setprecision(0) << "ticks/s : " << mTickRate
+             << std::setprecision(1) << " (x" << mSpeed << ")";
+        drawText(target, line.str(), sf::Color::White, LEGEND_MARGIN, lastLegendY, TIMING_FONT_SIZE);
+        lastLegendY += TIMING_FONT_SIZE + 4;
+    }
+    if (mTurbo) {
+        drawText(target, "turbo : on (T to stop)", sf::Color::Yellow, LEGEND_MARGIN, lastLegendY, TIMING_FONT_SIZE);
+        lastLegendY += TIMING_FONT_SIZE + 4;
+    }
+
+    // Degradation applied by the governor to hold the frame budget
+    if (mGovernor.getBudget() > sf::Time::Zero and !mTurbo) {
+        std::stringstream line;
+        line << "quality : " << FrameGovernor::levelName(mGovernor.getLevel())
+             << " (" << static_cast<int>(100 * mGovernor.getLoad()) << "% of budget)";
+        auto const color(mGovernor.getLevel() == FrameGovernor::FULL_QUALITY ? sf::Color::White : sf::Color::Yellow);
+        drawText(target, line.str(), color, LEGEND_MARGIN, lastLegendY, TIMING_FONT_SIZE);
+        lastLegendY += TIMING_FONT_SIZE + 4;
+    }
     /*
     drawOneControl(target, s::DELTAGLUC, mLab->getDelta(GLUCOSE),
     			   sf::Color::Blue, LEGEND_MARGIN, lastLegendY, FONT_SIZE);
@@ -845,6 +1016,24 @@ void Application::drawOneControl(sf::RenderWindow& target
     target.draw(legend);
 }
 
+void Application::drawText(sf::RenderWindow& target
+                           , std::string const& text
+                           , sf::Color color
+                           , size_t xcoord
+                           , size_t ycoord
+                           , size_t font_size
+                          )
+{
+    auto legend = sf::Text(text, getAppFont(), font_size);
+    legend.setPosition(xcoord, ycoord);
+#if SFML_VERSION_MAJOR >= 2 && SFML_VERSION_MINOR >= 4
+    legend.setFillColor(color);
+#else
+    legend.setColor(color);
+#endif
+    target.draw(legend);
+}
+
 void Application::setSimulationMode(SimulationMode mode)
 {
     mMode = mode;
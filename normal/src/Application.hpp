@@ -12,6 +12,7 @@
 #include <JSON/JSON.hpp>
 #include "Config.hpp"
 #include <Stats/Stats.hpp>
+#include <Utility/FrameGovernor.hpp>
 //#include <Utility/AnimalTracker.hpp>
 #include <Utility/Vec2d.hpp>
 
@@ -226,6 +227,9 @@ protected:
     /*!
      *  @brief Render the GUI, Simulation and Stats
      *
+     *  The frame is drawn but not displayed: run() displays it once it has
+     *  measured what the frame cost.
+     *
      *  @param simulationBackground Background of the simulation frame
      *  @param statsBackground      Background of the stats frame
      */
@@ -290,6 +294,20 @@ protected:
                         , size_t font_size
                        );
 
+    void drawText(sf::RenderWindow& target
+                  , std::string const& text
+                  , sf::Color color
+                  , size_t xcoord
+                  , size_t ycoord
+                  , size_t font_size
+                 );
+
+    /*!
+     * @brief Writes the timings of the last ticks (about ten seconds) as a
+     * Chrome trace, in the application directory
+     */
+    void writeTrace() const;
+
     void drawTitle(sf::RenderWindow& target, sf::Color color
                    , size_t xcoord
                    , size_t ycoord
@@ -319,6 +337,7 @@ protected:
     Environment* mEnvPPS; ///< Simulated environment for prey predator simulation
     Environment* mEnvNeuronal; ///< Simulated environment for neuronal simulation
     Stats* mStats;
+    FrameGovernor mGovernor; ///< Lowers the quality while the frames are over budget
     sf::View mHelpView;         ///< View for commands help
 
 
@@ -334,6 +353,9 @@ protected:
     // mDefaultTexture is used when a texture in the pool is not available
 
     bool         mPaused;            ///< Tells if the application is in pause or not
+    bool         mTurbo;             ///< Fast forward: steps as fast as possible, drawing now and then
+    double       mTickRate;          ///< Ticks per second, measured over the last half second
+    double       mSpeed;             ///< Simulated seconds per second, measured likewise
     bool         mIsResetting;       ///< Is true for one main loop iteration when resetting.
     bool         mIsSwitchingView;
     ///  This is useful to pause the clock while generating
@@ -413,6 +435,47 @@ sf::Texture& getAppTexture(std::string const& name);
 bool isDebugOn();
 bool isOrganViewOn();
 
+/*!
+ * @class WorldBinding
+ *
+ * @brief Bind a config (and optionally an env) to the calling thread
+ *
+ * While a binding is alive, getAppConfig() and getAppEnv() called from the
+ * same thread return the bound objects instead of the ones of the current
+ * Application. This is what allows several independent worlds to be
+ * simulated in one process, one world per thread (see Sweep).
+ *
+ * Bindings nest: the destructor restores whatever was bound before.
+ */
+class WorldBinding
+{
+public:
+    /*!
+     * @brief Bind only a config, e.g. while the env itself is built
+     *
+     * @param config config to use on this thread
+     */
+    WorldBinding(Config& config);
+
+    /*!
+     * @brief Bind a whole world
+     *
+     * @param config config to use on this thread
+     * @param env env to use on this thread
+     */
+    WorldBinding(Config& config, Environment& env);
+
+    /// Forbid copy
+    WorldBinding(WorldBinding const&) = delete;
+    WorldBinding& operator=(WorldBinding const&) = delete;
+
+    ~WorldBinding();
+
+private:
+    Config*      mPreviousConfig; ///< Binding to restore on destruction
+    Environment* mPreviousEnv;    ///< Binding to restore on destruction
+};
+
 /// Define a few macros
 
 
@@ -1,7 +1,11 @@
 #include "Config.hpp"
 #include <JSON/JSONSerialiser.hpp>
+Config::Config(std::string path) : Config(j::readFromFile(path))
+{
+}
+
 // window
-Config::Config(std::string path) : mConfig(j::readFromFile(path))
+Config::Config(j::Value const& cfg) : mConfig(cfg)
     , simulation_debug(mConfig["debug"].toBool())
     ,window_simulation_width(mConfig["window"]["simulation"]["width"].toDouble())
     , window_simulation_height(mConfig["window"]["simulation"]["height"].toDouble())
@@ -17,8 +21,20 @@ Config::Config(std::string path) : mConfig(j::readFromFile(path))
     , simulation_world_texture(mConfig["simulation"]["world"]["texture"].toString())
     , simulation_world_debug_texture(mConfig["simulation"]["world"]["debug texture"].toString())
     , simulation_world_size(mConfig["simulation"]["world"]["size"].toDouble())
+    , simulation_world_neighbour_skin(mConfig["simulation"]["world"]["neighbour skin"].toDouble())
+    , simulation_world_reorder_threshold(mConfig["simulation"]["world"]["reorder threshold"].toDouble())
+    , simulation_world_tiles(mConfig["simulation"]["world"]["tiles"].toInt())
+    , simulation_world_tile_workers(mConfig["simulation"]["world"]["tile workers"].toInt())
+    , simulation_schedule_food_generators(sf::seconds(mConfig["simulation"]["schedule"]["food generators"].toDouble()))
+    , simulation_schedule_entities(sf::seconds(mConfig["simulation"]["schedule"]["entities"].toDouble()))
+    , simulation_schedule_waves(sf::seconds(mConfig["simulation"]["schedule"]["waves"].toDouble()))
+    , simulation_schedule_deaths(sf::seconds(mConfig["simulation"]["schedule"]["deaths"].toDouble()))
     , simulation_time_factor(mConfig["simulation"]["time"]["factor"].toDouble())
     , simulation_time_max_dt(sf::seconds(mConfig["simulation"]["time"]["max dt"].toDouble()))
+    , simulation_time_background_update(mConfig["simulation"]["time"]["background update"].toBool())
+    , simulation_time_frame_budget(sf::seconds(mConfig["simulation"]["time"]["frame budget"].toDouble()))
+    , simulation_time_turbo_render_period(sf::seconds(mConfig["simulation"]["time"]["turbo"]["render period"].toDouble()))
+    , simulation_time_turbo_stepping_fraction(mConfig["simulation"]["time"]["turbo"]["stepping fraction"].toDouble())
 
 // food generator
     , food_generator_delta(mConfig["simulation"]["food generator"]["delta"].toDouble())
@@ -44,6 +60,7 @@ Config::Config(std::string path) : mConfig(j::readFromFile(path))
     , animal_base_energy_consumption(mConfig["simulation"]["animal"]["base consumption"].toDouble())
 // gerbil
     , gerbil_max_speed(mConfig["simulation"]["animal"]["gerbil"]["max speed"].toDouble())
+    , gerbil_perception_period(mConfig["simulation"]["animal"]["gerbil"]["perception period"].toDouble())
     , gerbil_mass(mConfig["simulation"]["animal"]["gerbil"]["mass"].toDouble())
     , gerbil_energy_loss_factor(mConfig["simulation"]["animal"]["gerbil"]["energy"]["loss factor"].toDouble())
     , gerbil_view_range(mConfig["simulation"]["animal"]["gerbil"]["view"]["range"].toDouble())
@@ -68,6 +85,7 @@ Config::Config(std::string path) : mConfig(j::readFromFile(path))
     , wave_gerbil_energy_loss_factor(mConfig["simulation"]["animal"]["gerbil"]["wave"]["loss factor"].toDouble())
 // scorpion
     , scorpion_max_speed(mConfig["simulation"]["animal"]["scorpion"]["max speed"].toDouble())
+    , scorpion_perception_period(mConfig["simulation"]["animal"]["scorpion"]["perception period"].toDouble())
     , scorpion_mass(mConfig["simulation"]["animal"]["scorpion"]["mass"].toDouble())
     , scorpion_energy_loss_factor(mConfig["simulation"]["animal"]["scorpion"]["energy"]["loss factor"].toDouble())
     , scorpion_view_range(mConfig["simulation"]["animal"]["scorpion"]["view"]["range"].toDouble())
@@ -29,6 +29,9 @@ private:
 public:
     Config(std::string path);
 
+    // builds a config from an already parsed (and possibly edited) json tree
+    explicit Config(j::Value const& cfg);
+
     // enables / disables debug mode
     void switchDebug();
     bool getDebug();
@@ -68,8 +71,20 @@ public:
     const std::string simulation_world_texture;
     const std::string simulation_world_debug_texture;
     const int  simulation_world_size;
+    const double  simulation_world_neighbour_skin; // margin of the neighbour lists of the animals
+    const double  simulation_world_reorder_threshold; // growth of the spread of the entities' order that triggers a re-sort
+    const int  simulation_world_tiles; // tiles per side updated in parallel, 0 or 1 for none
+    const int  simulation_world_tile_workers; // threads updating the tiles, 0 for one per hardware thread
+    const sf::Time  simulation_schedule_food_generators; // period of each subsystem of the update, 0 for every tick
+    const sf::Time  simulation_schedule_entities;
+    const sf::Time  simulation_schedule_waves;
+    const sf::Time  simulation_schedule_deaths;
     const double  simulation_time_factor;
     const sf::Time  simulation_time_max_dt;
+    const bool  simulation_time_background_update; // keep updating the env that isn't shown
+    const sf::Time  simulation_time_frame_budget; // cost above which a frame is degraded, 0 for never
+    const sf::Time  simulation_time_turbo_render_period; // wall time between two drawings in turbo mode, the drawing included
+    const double  simulation_time_turbo_stepping_fraction; // least share of that time spent stepping the simulation
 
     // organic entity
     const std::string entity_texture_tracked = "target.png";
@@ -102,6 +117,7 @@ public:
 
     // gerbils
     const double gerbil_max_speed;
+    const double gerbil_perception_period;
     const double gerbil_mass;
     const double gerbil_energy_loss_factor;
     const double gerbil_view_range;
@@ -128,6 +144,7 @@ public:
 
     // scorpion
     const double scorpion_max_speed;
+    const double scorpion_perception_period;
     const double scorpion_mass;
     const double scorpion_energy_loss_factor;
     const double scorpion_view_range;
@@ -0,0 +1,161 @@
+#include "EntityPool.hpp"
+#include <new>
+
+namespace // anonymous
+{
+
+/**
+ * @brief Prefix of every block, remembering where the block comes from
+ *
+ * Padded to 16 bytes so that what follows is aligned like malloc's memory.
+ */
+struct Header
+{
+    EntityPool* pool;      ///< nullptr for a heap block
+    std::size_t sizeClass;
+};
+
+std::size_t const HEADER_SIZE = 16;
+std::size_t const GRANULE = 16;          ///< size classes are multiples of it
+std::size_t const BLOCKS_PER_SLAB = 64;
+
+static_assert(sizeof(Header) <= HEADER_SIZE, "block header too large");
+
+thread_local EntityPool* activePool = nullptr;
+
+Header* headerOf(void* block)
+{
+    return reinterpret_cast<Header*>(static_cast<char*>(block) - HEADER_SIZE);
+}
+
+Header const* headerOf(void const* block)
+{
+    return reinterpret_cast<Header const*>(static_cast<char const*>(block) - HEADER_SIZE);
+}
+
+void* payloadOf(Header* header)
+{
+    return reinterpret_cast<char*>(header) + HEADER_SIZE;
+}
+
+/// Bytes taken in a slab by a block of the given class, header included
+std::size_t strideOf(std::size_t sizeClass)
+{
+    return HEADER_SIZE + sizeClass * GRANULE;
+}
+
+} // anonymous
+
+EntityPool::EntityPool()
+    : live_(0)
+    , reserved_(0)
+{
+}
+
+EntityPool::~EntityPool()
+{
+    release();
+}
+
+EntityPool::Scope::Scope(EntityPool& pool)
+    : previous_(activePool)
+{
+    activePool = &pool;
+}
+
+EntityPool::Scope::~Scope()
+{
+    activePool = previous_;
+}
+
+void* EntityPool::allocate(std::size_t size)
+{
+    // at least one granule: a free block must hold the free list link
+    std::size_t const sizeClass((size + GRANULE - 1) / GRANULE + (size == 0 ? 1 : 0));
+
+    if (activePool != nullptr) {
+        return activePool->take(sizeClass);
+    }
+
+    Header* header(static_cast<Header*>(::operator new(strideOf(sizeClass))));
+    header->pool = nullptr;
+    header->sizeClass = sizeClass;
+    return payloadOf(header);
+}
+
+void EntityPool::deallocate(void* block)
+{
+    if (block == nullptr) return;
+
+    Header* header(headerOf(block));
+    if (header->pool != nullptr) {
+        header->pool->give(block, header->sizeClass);
+    } else {
+        ::operator delete(header);
+    }
+}
+
+std::size_t EntityPool::blockBytes(void const* block)
+{
+    return strideOf(headerOf(block)->sizeClass);
+}
+
+void EntityPool::release()
+{
+    for (auto slab : slabs_) {
+        ::operator delete(slab);
+    }
+    slabs_.clear();
+    free_lists_.clear();
+    live_ = 0;
+    reserved_ = 0;
+}
+
+std::size_t EntityPool::liveCount() const
+{
+    return live_;
+}
+
+std::size_t EntityPool::reservedBytes() const
+{
+    return reserved_;
+}
+
+void* EntityPool::take(std::size_t sizeClass)
+{
+    if (sizeClass >= free_lists_.size()) {
+        free_lists_.resize(sizeClass + 1, nullptr);
+    }
+    if (free_lists_[sizeClass] == nullptr) {
+        grow(sizeClass);
+    }
+    void* block(free_lists_[sizeClass]);
+    free_lists_[sizeClass] = *static_cast<void**>(block);
+    ++live_;
+    return block;
+}
+
+void EntityPool::give(void* block, std::size_t sizeClass)
+{
+    *static_cast<void**>(block) = free_lists_[sizeClass];
+    free_lists_[sizeClass] = block;
+    --live_;
+}
+
+void EntityPool::grow(std::size_t sizeClass)
+{
+    std::size_t const stride(strideOf(sizeClass));
+    char* slab(static_cast<char*>(::operator new(stride * BLOCKS_PER_SLAB)));
+    slabs_.push_back(slab);
+    reserved_ += stride * BLOCKS_PER_SLAB;
+
+    // headers are written once; the blocks are chained in address order
+    for (std::size_t i(BLOCKS_PER_SLAB); i-- > 0;) {
+        Header* header(reinterpret_cast<Header*>(slab + i * stride));
+        header->pool = this;
+        header->sizeClass = sizeClass;
+        void* block(payloadOf(header));
+        *static_cast<void**>(block) = free_lists_[sizeClass];
+        free_lists_[sizeClass] = block;
+    }
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class EntityPool
+ * @brief Slab allocator for the organic entities of one environment
+ *
+ * Entities are created and destroyed all the time (births, food spawns,
+ * deaths) but only come in a handful of sizes. The pool keeps one free list
+ * per size class, carved out of large slabs, so that after warm-up a birth
+ * or a death never reaches malloc; freed blocks are reused on later ticks.
+ *
+ * OrganicEntity::operator new takes its memory from the pool made active on
+ * the current thread by a Scope (the environment opens one while updating),
+ * and falls back to the heap otherwise. Every block remembers where it came
+ * from, so deleting an entity always returns it to the right place.
+ *
+ * The pool is not thread-safe: it belongs to one environment, which is only
+ * ever updated by one thread at a time.
+ */
+class EntityPool
+{
+public:
+    EntityPool();
+
+    EntityPool(const EntityPool&) = delete;
+    EntityPool& operator=(const EntityPool&) = delete;
+
+    /**
+     * @brief Frees every slab
+     */
+    ~EntityPool();
+
+    /**
+     * @brief Makes a pool the active one of the current thread for a scope
+     *
+     * Scopes nest: the previously active pool is restored on destruction.
+     */
+    class Scope
+    {
+    public:
+        explicit Scope(EntityPool& pool);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        EntityPool* previous_;
+    };
+
+    /**
+     * @brief Allocates size bytes from the active pool, or from the heap if none
+     */
+    static void* allocate(std::size_t size);
+
+    /**
+     * @brief Gives back a block obtained from allocate()
+     */
+    static void deallocate(void* block);
+
+    /**
+     * @brief Bytes taken by a block obtained from allocate(), its header and
+     *        the rounding up to its size class included
+     */
+    static std::size_t blockBytes(void const* block);
+
+    /**
+     * @brief Frees all the slabs at once
+     *
+     * Every entity allocated from the pool must already have been
+     * destroyed: the environment calls this once it has deleted them all.
+     */
+    void release();
+
+    /**
+     * @brief Number of blocks handed out and not given back yet
+     */
+    std::size_t liveCount() const;
+
+    /**
+     * @brief Number of bytes reserved in slabs
+     */
+    std::size_t reservedBytes() const;
+
+private:
+    void* take(std::size_t sizeClass);
+    void give(void* block, std::size_t sizeClass);
+    void grow(std::size_t sizeClass);
+
+    std::vector<void*> free_lists_; ///< head of the free list of each size class
+    std::vector<void*> slabs_;
+    std::size_t live_;
+    std::size_t reserved_;
+};
@@ -4,7 +4,10 @@
 #include "Environment.hpp"
 #include "../Application.hpp"
 #include "../Utility/Utility.hpp"
+#include "../Utility/Profiler.hpp"
 #include <algorithm>
+#include <cmath>
+#include <iterator>
 #include "../Animal/NeuronalScorpion/Sensor.hpp"
 #include <map>
 #include <string>
@@ -12,12 +15,27 @@ void Environment::addEntity(OrganicEntity* organicEntity)
 {
     if(organicEntity != nullptr) {
 
-        organic_entity_.push_back(organicEntity);
+        if (organicEntity->isStatic()) {
+            static_entities_.insert(organicEntity);
+        } else {
+            organic_entity_.push_back(organicEntity);
+            sight_entities_.push_back(organicEntity);
+            sight_x_.push_back(organicEntity->getPosition().x);
+            sight_y_.push_back(organicEntity->getPosition().y);
+            neighbours_.added(organicEntity);
+            rebucket(organicEntity);
+            organicEntity->enterWorld(timers_);
+        }
+        organicEntity->scheduleTimers(*this);
     }
 }
 
 void Environment::addWave(Wave* wa)
 {
+    if (isDeferring()) {
+        defer([this, wa] { addWave(wa); });
+        return;
+    }
     if(wa!= nullptr) {
         env_list_waves_.push_back(wa);
     }
@@ -40,48 +58,192 @@ void Environment::addObstacle(CircularCollider* roc)
 {
     if(roc != nullptr) {
         env_list_obstacles_.push_back(roc);
+        obstacle_grid_.markDirty();
     }
 }
 
 void Environment::update(sf::Time dt)
 {
-    for( const auto& FG : food_generator_) {
-        FG->update(dt);
+    // births and food spawns of this step come from our own slabs
+    EntityPool::Scope poolScope(entity_pool_);
+    rebuildSightIndex();
+
+    // each subsystem runs at its own rate, with the time elapsed since it
+    // last ran
+    food_clock_.setPeriod(getAppConfig().simulation_schedule_food_generators);
+    entities_clock_.setPeriod(getAppConfig().simulation_schedule_entities);
+    waves_clock_.setPeriod(getAppConfig().simulation_schedule_waves);
+    deaths_clock_.setPeriod(getAppConfig().simulation_schedule_deaths);
+
+    if (food_clock_.advance(dt)) {
+        ScopedTimer timer(Phase::FoodGenerators);
+        sf::Time const elapsed(food_clock_.consume());
+        for( const auto& FG : food_generator_) {
+            FG->update(*this, elapsed);
+        }
     }
 
-    for( auto& organicEntity : organic_entity_) {
+    bool const entitiesDue(entities_clock_.advance(dt));
+    if (entitiesDue) {
+        ScopedTimer timer(Phase::Entities);
+        sf::Time const elapsed(entities_clock_.consume());
+        timers_.advance(elapsed, [this](OrganicEntity* owner, int kind) {
+            if (kind == OrganicEntity::END_OF_LIFE) {
+                expired_.push_back(owner);
+            } else {
+                owner->onTimer(*this, kind);
+            }
+        });
+        moveRebucketed();
+
+        // with tiles, what the animals see is looked up in parallel first;
+        // the prey seen are alerted before the updates, so that they react
+        // in this tick as they would without tiles
+        tiles_.setup(getAppConfig().simulation_world_tiles, getAppConfig().simulation_world_tile_workers);
+        if (tiles_.active()) {
+            perceiveInTiles();
+            tiles_.deliverAlerts();
+        }
 
-        if(organicEntity != nullptr ) {
-            organicEntity->update(dt);
-            organicEntity->OrganicEntity::update(dt);
+        // the animals decide from where everybody stood at the start of the
+        // tick, then move all at once, one loop per bucket (on each tile,
+        // with tiles); an entity whose bucket changes on the way is moved
+        // after the loops
+        steering_.open();
+        std::size_t const ticked(organic_entity_.size());
+        if (tiles_.active()) {
+            updateInTiles(elapsed);
+        } else {
+            for (auto organicEntity : buckets_[OrganicEntity::ACTIVE_BUCKET]) {
+                organicEntity->update(*this, elapsed);
+            }
+            for (auto organicEntity : buckets_[OrganicEntity::WANDERING_BUCKET]) {
+                organicEntity->wander(*this, elapsed);
+            }
+            for (auto organicEntity : buckets_[OrganicEntity::HOLDING_BUCKET]) {
+                organicEntity->hold(*this, elapsed);
+            }
+        }
+        for (auto organicEntity : buckets_[OrganicEntity::SERIAL_BUCKET]) {
+            organicEntity->update(*this, elapsed);
+        }
+        // entities born during the loops, if any, are updated last
+        if (organic_entity_.size() > ticked) {
+            for (auto it(std::next(organic_entity_.begin(), ticked)); it != organic_entity_.end(); ++it) {
+                (*it)->update(*this, elapsed);
+            }
+        }
+        steering_.close();
+        steering_.integrate(elapsed.asSeconds(), getAppConfig().simulation_world_size);
+        if (tiles_.active()) {
+            for (auto& tile : tiles_.getTiles()) {
+                applySteering(tile.steering, elapsed);
+            }
+        }
+        applySteering(steering_, elapsed);
+        moveRebucketed();
+
+        // largest move around the torus, for the neighbour lists, and the
+        // energies for the death sweep
+        double const worldSize(getAppConfig().simulation_world_size);
+        double drift(0);
+        std::size_t slot(0);
+        death_energy_.resize(sight_x_.size());
+        for (auto const& organicEntity : organic_entity_) {
+            if (organicEntity != nullptr) {
+                Vec2d const& position(organicEntity->getPosition());
+                double dx(std::abs(position.x - sight_x_[slot]));
+                double dy(std::abs(position.y - sight_y_[slot]));
+                dx = std::min(dx, worldSize - dx);
+                dy = std::min(dy, worldSize - dy);
+                drift = std::max(drift, std::sqrt(dx * dx + dy * dy));
+                sight_x_[slot] = position.x;
+                sight_y_[slot] = position.y;
+                death_energy_[slot] = organicEntity->getEnergy();
+            }
+            ++slot;
         }
+        neighbours_.moved(drift);
+        spatial_order_.setup(getAppConfig().simulation_world_reorder_threshold);
+        spatial_order_.observe(sight_x_.data(), sight_y_.data(), sight_x_.size(), worldSize);
     }
 
-    for( auto& wav : env_list_waves_) {
+    if (waves_clock_.advance(dt)) {
+        ScopedTimer timer(Phase::Waves);
+        sf::Time const elapsed(waves_clock_.consume());
+        for( auto& wav : env_list_waves_) {
 
-        if(wav != nullptr ) {
-            wav->update(dt);
+            if(wav != nullptr ) {
+                wav->update(*this, elapsed);
+            }
         }
     }
 
-    for (auto& OE : organic_entity_) {
-        if(OE != nullptr ) {
-            if ( (OE->getAge() >= OE->getAgeLimit()) or  (OE->getEnergy() <= getAppConfig().animal_min_energy)) {
+    ScopedTimer timer(Phase::Deaths);
+    // ages are checked by the END_OF_LIFE timers: only the energies are,
+    // in one pass over their array. The energies only change with the
+    // entities, so the sweep waits for a tick where they were updated.
+    // The entities that expired or were eaten are removed on the tick
+    // they died, whatever the rate of the sweep.
+    bool const deathsDue(deaths_clock_.advance(dt) and entitiesDue);
+    double const minEnergy(getAppConfig().animal_min_energy);
+    std::size_t starving(0);
+    if (deathsDue) {
+        deaths_clock_.consume();
+        for (std::size_t i(0); i < death_energy_.size(); ++i) {
+            starving += death_energy_[i] <= minEnergy;
+        }
+    }
+    std::vector<OrganicEntity*> dead;
+    if (starving > 0 or !expired_.empty()) {
+        std::sort(expired_.begin(), expired_.end());
+        std::size_t slot(0);
+        for (auto& OE : organic_entity_) {
+            if (OE != nullptr
+                and ((deathsDue and death_energy_[slot] <= minEnergy)
+                     or std::binary_search(expired_.begin(), expired_.end(), OE))) {
                 for (auto& other : organic_entity_) {
                     if (other != nullptr && other != OE) {
                         other->forgetEntity(OE);
                     }
                 }
+                OE->cancelTimers(*this);
+                OE->leaveWorld(timers_);
+                removeFromBucket(OE);
                 kill_list_.push_back(OE);
+                dead.push_back(OE);
                 OE = nullptr;
             }
+            ++slot;
+        }
+        expired_.clear();
+    }
+    // static entities are not visited: they were marked (eaten, expired)
+    for (auto& OE : marked_for_death_) {
+        if (static_entities_.remove(OE)) {
+            for (auto& other : organic_entity_) {
+                if (other != nullptr) {
+                    other->forgetEntity(OE);
+                }
+            }
+            OE->cancelTimers(*this);
+            kill_list_.push_back(OE);
         }
     }
+    marked_for_death_.clear();
+    std::sort(dead.begin(), dead.end());
+    neighbours_.forget(dead);
+    neighbours_.endTick();
     while(!(kill_list_.empty())) {
         delete kill_list_.front();
         kill_list_.pop_front();
     }
     organic_entity_.erase(std::remove(organic_entity_.begin(), organic_entity_.end(), nullptr), organic_entity_.end());
+    if (spatial_order_.due()) {
+        spatial_order_.sort(organic_entity_, getAppConfig().simulation_world_size);
+        rebuildBuckets();
+    }
+    rebuildSightIndex();
 
     for(auto& Wav : env_list_waves_) {
         if (Wav != nullptr) {
@@ -98,25 +260,197 @@ void Environment::update(sf::Time dt)
 
 std::list<OrganicEntity*> Environment::getEntitiesInSightForAnimal(Animal* animal) const
 {
-
     std::list<OrganicEntity*> visibleEntities;
+    forEachInSight(animal, [&visibleEntities](OrganicEntity* entity) {
+        visibleEntities.push_back(entity);
+    });
+    return visibleEntities;
+}
 
-    if (!organic_entity_.empty()) {
-        for (const auto& entity: organic_entity_) {
-            if (animal->isTargetInSight(entity->getPosition())) {
+std::size_t Environment::selectMovingInSight(Animal const* animal, OrganicEntity* const*& candidates,
+                                             std::uint32_t const*& selected) const
+{
+    if (WorldTiles::Tile* const tile = WorldTiles::current()) {
+        candidates = tile->entities.data();
+        tile->selected.resize(tile->entities.size());
+        selected = tile->selected.data();
+        return animal->getViewCone().select(tile->xs.data(), tile->ys.data(), tile->entities.size(),
+                                            tile->selected.data());
+    }
 
-                visibleEntities.push_back(entity);
-            }
+    neighbours_.setup(getAppConfig().simulation_world_neighbour_skin, getAppConfig().simulation_world_size);
+    double const* xs(sight_x_.data());
+    double const* ys(sight_y_.data());
+    std::size_t count(sight_entities_.size());
+    candidates = sight_entities_.data();
+    if (neighbours_.gather(animal, animal->getPosition(), animal->getViewDistance(),
+                           sight_entities_.data(), sight_x_.data(), sight_y_.data(), sight_entities_.size())) {
+        xs = neighbours_.getXs().data();
+        ys = neighbours_.getYs().data();
+        count = neighbours_.getEntities().size();
+        candidates = neighbours_.getEntities().data();
+    }
+    sight_selected_.resize(count);
+    selected = sight_selected_.data();
+    return animal->getViewCone().select(xs, ys, count, sight_selected_.data());
+}
+
+void Environment::perceiveInTiles()
+{
+    // wide enough for any animal to find what it sees on its own tile
+    Config& config(getAppConfig());
+    double const halo(std::max(config.gerbil_view_distance, config.scorpion_view_distance));
+    tiles_.assign(sight_entities_.data(), sight_x_.data(), sight_y_.data(), sight_entities_.size(),
+                  config.simulation_world_size, halo);
+    tiles_.run([this, &config](WorldTiles::Tile& tile) {
+        // the species parameters are read through the config of the thread
+        WorldBinding binding(config, *this);
+        for (auto entity : tile.owned) {
+            entity->prepareUpdate(*this);
+        }
+    });
+}
+
+void Environment::updateInTiles(sf::Time dt)
+{
+    Config& config(getAppConfig());
+    double const worldSize(config.simulation_world_size);
+    tiles_.run([this, &config, dt, worldSize](WorldTiles::Tile& tile) {
+        WorldBinding binding(config, *this);
+        tile.steering.open();
+        // the tile keeps the order of the buckets: all the active entities
+        // first, then the wandering, then the holding ones
+        for (auto entity : tile.owned) {
+            if (entity->bucket_ == OrganicEntity::ACTIVE_BUCKET) entity->update(*this, dt);
+        }
+        for (auto entity : tile.owned) {
+            if (entity->bucket_ == OrganicEntity::WANDERING_BUCKET) entity->wander(*this, dt);
+        }
+        for (auto entity : tile.owned) {
+            if (entity->bucket_ == OrganicEntity::HOLDING_BUCKET) entity->hold(*this, dt);
+        }
+        tile.steering.close();
+        tile.steering.integrate(dt.asSeconds(), worldSize);
+    });
+
+    // a change asked for by two tiles goes to the first one
+    for (auto& tile : tiles_.getTiles()) {
+        rebucketed_.insert(rebucketed_.end(), tile.rebucketed.begin(), tile.rebucketed.end());
+        tile.rebucketed.clear();
+        for (auto& change : tile.deferred) {
+            change();
         }
-        return visibleEntities;
+        tile.deferred.clear();
     }
-    visibleEntities.clear();
-    return visibleEntities;
+    tiles_.deliverAlerts();
+}
+
+void Environment::applySteering(SteeringBatch& steering, sf::Time dt)
+{
+    for (std::size_t i(0); i < steering.size(); ++i) {
+        steering.getOwner(i)->applySteering(*this, dt, steering.getPosition(i),
+                                            steering.getDirection(i), steering.getSpeed(i));
+    }
+    steering.clear();
+}
+
+void Environment::defer(std::function<void()> change)
+{
+    if (WorldTiles::Tile* const tile = WorldTiles::current()) {
+        tile->deferred.push_back(std::move(change));
+    } else {
+        change();
+    }
+}
 
+bool Environment::isDeferring() const
+{
+    return WorldTiles::current() != nullptr;
+}
+
+void Environment::alert(OrganicEntity* entity) const
+{
+    if (WorldTiles::Tile* const tile = WorldTiles::current()) {
+        tile->alerted.push_back(entity);
+    } else {
+        entity->alert();
+    }
+}
+
+bool Environment::seesPlainDistances(Animal const* animal) const
+{
+    return 2 * animal->getViewDistance() <= getAppConfig().simulation_world_size;
+}
+
+void Environment::rebucket(OrganicEntity* entity)
+{
+    if (WorldTiles::Tile* const tile = WorldTiles::current()) {
+        tile->rebucketed.push_back(entity);
+        return;
+    }
+    rebucketed_.push_back(entity);
+}
+
+void Environment::moveRebucketed()
+{
+    for (auto entity : rebucketed_) {
+        OrganicEntity::UpdateBucket const bucket(entity->getUpdateBucket());
+        if (bucket != entity->bucket_) {
+            removeFromBucket(entity);
+            entity->bucket_ = bucket;
+            entity->bucket_slot_ = buckets_[bucket].size();
+            buckets_[bucket].push_back(entity);
+        }
+    }
+    rebucketed_.clear();
+}
+
+void Environment::removeFromBucket(OrganicEntity* entity)
+{
+    if (entity->bucket_ == OrganicEntity::NO_BUCKET) return;
+    // the last entity of the bucket takes the place of the removed one
+    std::vector<OrganicEntity*>& bucket(buckets_[entity->bucket_]);
+    OrganicEntity* const last(bucket.back());
+    bucket[entity->bucket_slot_] = last;
+    last->bucket_slot_ = entity->bucket_slot_;
+    bucket.pop_back();
+    entity->bucket_ = OrganicEntity::NO_BUCKET;
+}
+
+void Environment::rebuildBuckets()
+{
+    // refills the buckets in the order of organic_entity_, and so in its
+    // spatial order
+    for (auto& bucket : buckets_) {
+        bucket.clear();
+    }
+    for (auto organicEntity : organic_entity_) {
+        if (organicEntity != nullptr) {
+            organicEntity->bucket_ = OrganicEntity::NO_BUCKET;
+            rebucketed_.push_back(organicEntity);
+        }
+    }
+    moveRebucketed();
+}
+
+void Environment::rebuildSightIndex()
+{
+    sight_entities_.assign(organic_entity_.begin(), organic_entity_.end());
+    sight_x_.resize(sight_entities_.size());
+    sight_y_.resize(sight_entities_.size());
+    for (std::size_t i(0); i < sight_entities_.size(); ++i) {
+        if (sight_entities_[i] != nullptr) {
+            sight_x_[i] = sight_entities_[i]->getPosition().x;
+            sight_y_[i] = sight_entities_[i]->getPosition().y;
+        }
+    }
 }
 
 void Environment::draw(sf::RenderTarget& targetWindow)
 {
+    static_entities_.forEach([&targetWindow](OrganicEntity* entity) {
+        entity->draw(targetWindow);
+    });
     for (const auto& organic_entity: organic_entity_) {
         organic_entity->draw(targetWindow);
     }
@@ -165,24 +499,99 @@ void Environment::clean()
     for ( const auto& organicEntity: organic_entity_ ) {
         delete organicEntity;
     }
+    static_entities_.forEach([](OrganicEntity* entity) {
+        delete entity;
+    });
+    static_entities_.clear();
+    marked_for_death_.clear();
     for ( const auto& food_generator: food_generator_ ) {
         delete food_generator;
     }
+    for ( const auto& wave: env_list_waves_ ) {
+        delete wave;
+    }
+    for ( const auto& rock: env_list_rocks_ ) {
+        delete rock;
+    }
     organic_entity_.clear();
+    timers_.clear();
+    sight_entities_.clear();
+    sight_x_.clear();
+    sight_y_.clear();
+    neighbours_.clear();
+    spatial_order_.clear();
+    for (auto& bucket : buckets_) {
+        bucket.clear();
+    }
+    rebucketed_.clear();
+    expired_.clear();
+    food_clock_.reset();
+    entities_clock_.reset();
+    waves_clock_.reset();
+    deaths_clock_.reset();
     food_generator_.clear();
+    env_list_waves_.clear();
+    env_list_rocks_.clear();
+    env_list_obstacles_.clear();
+    obstacle_grid_.markDirty();
+    // every pooled entity has been deleted above: drop the slabs wholesale
+    entity_pool_.release();
 }
 
-std::list<CircularCollider*> Environment::getIsColliding(CircularCollider* CC)
+TimerWheel& Environment::getTimers()
 {
-    std::list<CircularCollider*> colliders;
-    for (const auto& Ob : env_list_obstacles_) {
-        if(Ob != nullptr) {
-            if (Ob->isColliding(CircularCollider(CC->getPosition(),CC->getRadius()))) {
-                colliders.push_back(Ob);
-            }
+    return timers_;
+}
+
+SteeringBatch& Environment::getSteering()
+{
+    if (WorldTiles::Tile* const tile = WorldTiles::current()) {
+        return tile->steering;
+    }
+    return steering_;
+}
+
+void Environment::setQuality(SimulationQuality const& quality)
+{
+    quality_ = quality;
+}
+
+SimulationQuality const& Environment::getQuality() const
+{
+    return quality_;
+}
+
+double Environment::nextPhase()
+{
+    phase_ += 0.6180339887498949;
+    if (phase_ >= 1) phase_ -= 1;
+    return phase_;
+}
+
+Environment::Footprint Environment::getTickedFootprint() const
+{
+    Footprint footprint;
+    for (auto organicEntity : organic_entity_) {
+        if (organicEntity != nullptr) {
+            ++footprint.entities;
+            footprint.bytes += organicEntity->getBlockBytes();
+            footprint.heap_bytes += organicEntity->getHeapBytes();
         }
     }
-    return colliders;
+    return footprint;
+}
+
+EntityPool const& Environment::getEntityPool() const
+{
+    return entity_pool_;
+}
+
+ObstacleGrid const& Environment::getObstacleGrid() const
+{
+    if (obstacle_grid_.isDirty()) {
+        obstacle_grid_.build(env_list_obstacles_, getAppConfig().simulation_world_size);
+    }
+    return obstacle_grid_;
 }
 
 double  Environment::envSensorActivationIntensityCumulated(Sensor* sen)
@@ -210,8 +619,18 @@ unsigned int Environment::countScorpions() const
 
 unsigned int Environment::countFood() const
 {
-    return std::count_if(organic_entity_.begin(), organic_entity_.end(),
-                         [](OrganicEntity* o) { return o->isFood(); });
+    // all the food is static
+    return static_entities_.size();
+}
+
+void Environment::markForDeath(OrganicEntity* entity)
+{
+    if (entity == nullptr) return;
+    if (entity->isStatic()) {
+        marked_for_death_.push_back(entity);
+    } else {
+        expired_.push_back(entity);
+    }
 }
 
 unsigned int Environment::countRocks() const
@@ -12,8 +12,22 @@ class Sensor;
 #include "Wave.hpp"
 #include "../Obstacle/Rock.hpp"
 #include "../Obstacle/CircularCollider.hpp"
+#include "../Obstacle/ObstacleGrid.hpp"
+#include "EntityPool.hpp"
+#include "TimerWheel.hpp"
+#include "StaticEntityGrid.hpp"
+#include "NeighbourLists.hpp"
+#include "SpatialOrder.hpp"
+#include "SubsystemClock.hpp"
+#include "WorldTiles.hpp"
+#include "../Utility/FrameGovernor.hpp"
+#include "../Animal/SteeringBatch.hpp"
+#include <functional>
 #include <map>
 #include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include <limits>
 
 /**
  * @class Environment
@@ -66,6 +80,8 @@ public:
     
     /**
      * @brief Adds a wave to the environment
+     *
+     * On a tile the wave is added once the tiles are done, see defer().
      * 
      * @param wave Pointer to the Wave to add
      */
@@ -107,25 +123,123 @@ public:
     /**
      * @brief Gets all entities that are within sight of a specific animal
      * 
+     * Tests every moving entity at once against the animal's view cone (see
+     * Animal::getViewCone()), then the static ones in the cells the cone
+     * covers. Moving entities come first in the result, static ones after.
+     * The animal itself is never part of the result.
+     *
      * @param animal The animal to check sight for
      * @return List of pointers to OrganicEntity objects in sight
      */
     std::list<OrganicEntity*> getEntitiesInSightForAnimal(Animal* animal) const;
+
+    /**
+     * @brief Calls f on every entity within sight of an animal
+     *
+     * Same entities, in the same order, as getEntitiesInSightForAnimal()
+     * but without building a list.
+     *
+     * @param animal The animal to check sight for
+     * @param f Callable taking an OrganicEntity*
+     */
+    template <typename F>
+    void forEachInSight(Animal const* animal, F f) const
+    {
+        OrganicEntity* const* candidates;
+        std::uint32_t const* selected;
+        std::size_t const count(selectMovingInSight(animal, candidates, selected));
+        for (std::size_t i(0); i < count; ++i) {
+            OrganicEntity* const entity(candidates[selected[i]]);
+            if (entity != nullptr and entity != animal) f(entity);
+        }
+        WorldTiles::Tile* const tile(WorldTiles::current());
+        static_entities_.forEachInCone(animal->getViewCone(), animal->getPosition(), animal->getViewDistance(), f,
+                                       tile != nullptr ? &tile->static_selected : nullptr);
+    }
+
+    /**
+     * @brief Finds the closest entity within sight of an animal that
+     *        satisfies a predicate
+     *
+     * Equivalent to Animal::findClosest() over the entities in sight that
+     * satisfy the predicate, without building any list: the moving entities
+     * are tested in one pass, then the static ones cell ring by cell ring
+     * from the animal's cell, stopping at the first ring that can't hold
+     * anything closer than what was found.
+     *
+     * @param animal The animal looking
+     * @param accept Callable taking an OrganicEntity* and returning true
+     *        for the entities looked for
+     * @return The closest entity accepted, or nullptr if none is in sight
+     */
+    template <typename F>
+    OrganicEntity* findClosestInSight(Animal const* animal, F accept) const
+    {
+        OrganicEntity* closest(nullptr);
+        double best(std::numeric_limits<double>::max());
+        OrganicEntity* const* candidates;
+        std::uint32_t const* selected;
+        std::size_t const count(selectMovingInSight(animal, candidates, selected));
+        for (std::size_t i(0); i < count; ++i) {
+            OrganicEntity* const entity(candidates[selected[i]]);
+            if (entity == nullptr or entity == animal or !accept(entity)) continue;
+            double const d(animal->distanceTo(entity->getPosition()));
+            if (d <= best) {
+                best = d;
+                closest = entity;
+            }
+        }
+
+        WorldTiles::Tile* const tile(WorldTiles::current());
+        OrganicEntity* const other(static_entities_.findClosestInCone(animal->getViewCone(), animal->getPosition(),
+                                   animal->getViewDistance(), best, seesPlainDistances(animal),
+        [animal, &accept](OrganicEntity* entity) {
+            return accept(entity) ? animal->distanceTo(entity->getPosition()) : -1.0;
+        }, tile != nullptr ? &tile->static_selected : nullptr));
+        return other != nullptr ? other : closest;
+    }
     
     /**
-     * @brief Gets all obstacles that collide with a specific collider
-     * 
+     * @brief Calls f on every obstacle colliding with a collider
+     *
+     * The obstacles are found through the obstacle grid, in the order they
+     * were added, all before f is first called, so f may move the collider.
+     *
      * @param collider The collider to check collisions with
-     * @return List of pointers to CircularCollider objects that are colliding
+     * @param f Callable taking a CircularCollider*
      */
-    std::list<CircularCollider*> getIsColliding(CircularCollider* collider);
+    template <typename F>
+    void forEachColliding(CircularCollider const& collider, F f) const
+    {
+        // the circle of a collider built from it (whose constructor halves the radius)
+        CircularCollider const probe(collider.getPosition(), collider.getRadius());
+        getObstacleGrid().forEachColliding(probe.getPosition(), probe.getRadius(), f);
+    }
     
     /**
      * @brief Marks an entity for death
+     *
+     * The entity is removed and deleted at the end of the current update:
+     * static entities (see OrganicEntity::isStatic()) from their grid, the
+     * others with the entities whose END_OF_LIFE fired, without waiting
+     * for the energy sweep. Marking an entity more than once is harmless.
+     * Not on a tile: see defer().
      * 
      * @param entity The entity to mark for death
      */
     void markForDeath(OrganicEntity* entity);
+
+    /**
+     * @brief Tells that the update bucket of a ticked entity (see
+     *        OrganicEntity::getUpdateBucket()) may have changed
+     *
+     * The entity is moved to its bucket before the next update loops, or
+     * right after the current ones: it finishes the tick in the loop it
+     * was in. On a tile, the tile keeps the entity until it is done.
+     *
+     * @param entity The entity
+     */
+    void rebucket(OrganicEntity* entity);
     
     /**
      * @brief Resets the environment to its initial state
@@ -184,11 +298,194 @@ public:
         clean();
     }
 
+    /**
+     * @brief Timers of the entities, advanced with the simulation time
+     *
+     * Due timers are delivered through OrganicEntity::onTimer() at the
+     * start of each update, before the entities move. On a tile the wheel
+     * is only read: timers are scheduled and cancelled through defer().
+     */
+    TimerWheel& getTimers();
+
+    /**
+     * @brief Batch moving all the animals at the end of the entities phase
+     *
+     * Open during update(): animals add their move to it instead of moving
+     * one at a time. On a tile, the batch of the tile.
+     */
+    SteeringBatch& getSteering();
+
+    /**
+     * @brief Runs a change to the world beyond the entity being updated
+     *
+     * Right away, except on a tile (see WorldTiles): the tiles are updated
+     * at the same time and only change their own entities, so the change
+     * is held until they are all done, then run on the updating thread,
+     * tile after tile in the order it was asked for.
+     *
+     * @param change What to do
+     */
+    void defer(std::function<void()> change);
+
+    /**
+     * @brief Tells whether defer() holds the changes, i.e. whether the
+     *        calling thread is updating a tile
+     */
+    bool isDeferring() const;
+
+    /**
+     * @brief Sets the quality the next updates run at, lowered by the
+     *        application's FrameGovernor while the frames are too slow
+     */
+    void setQuality(SimulationQuality const& quality);
+
+    SimulationQuality const& getQuality() const;
+
+    /**
+     * @brief Warns an entity that a predator has it in sight
+     *
+     * On a tile the alert is held until the tiles are done, so that the
+     * entities of other tiles are only changed from the updating thread;
+     * it is delivered before the updates of the tick when raised by the
+     * perception, after them when raised by an update.
+     */
+    void alert(OrganicEntity* entity) const;
+
+    /**
+     * @brief Gives the phase of the next entity doing some periodic work
+     *
+     * Successive phases follow the golden ratio sequence, so that entities
+     * added one after the other spread their work evenly over the period.
+     *
+     * @return Fraction of the period, in [0, 1)
+     */
+    double nextPhase();
+
+    /**
+     * @brief Memory taken by a set of entities
+     */
+    struct Footprint
+    {
+        std::size_t entities = 0;
+        std::size_t bytes = 0;      ///< memory blocks of the entities
+        std::size_t heap_bytes = 0; ///< what the entities allocated themselves
+    };
+
+    /**
+     * @brief Memory taken by the entities updated every tick (the animals)
+     */
+    Footprint getTickedFootprint() const;
+
+    /**
+     * @brief Memory pool the entities born during update() are allocated from
+     */
+    EntityPool const& getEntityPool() const;
+
 private:
-    std::list<OrganicEntity*> organic_entity_;   ///< List of all organic entities in the environment
+    EntityPool entity_pool_;                       ///< Owns the memory of the entities born here
+    std::list<OrganicEntity*> organic_entity_;   ///< List of the organic entities updated every tick
+    StaticEntityGrid static_entities_;           ///< Organic entities that are never updated (food)
+    std::vector<OrganicEntity*> marked_for_death_; ///< Static entities to remove at the end of the update
+    TimerWheel timers_;                          ///< Pending timers of the entities
+    SteeringBatch steering_;                     ///< Moves of the animals during update()
+    SpatialOrder spatial_order_;                 ///< Sorts organic_entity_ along a space-filling curve
+    std::vector<OrganicEntity*> buckets_[OrganicEntity::UPDATE_BUCKETS]; ///< organic_entity_ by update bucket
+    std::vector<OrganicEntity*> rebucketed_;     ///< Entities to move to their bucket, see rebucket()
+    std::vector<OrganicEntity*> expired_;        ///< Ticked entities that expired or were marked for death during the update
+    SubsystemClock food_clock_;                  ///< Rate of the food generators
+    SubsystemClock entities_clock_;              ///< Rate of the timers, entity updates and moves
+    SubsystemClock waves_clock_;                 ///< Rate of the waves
+    SubsystemClock deaths_clock_;                ///< Rate of the sweep for starved and expired entities
+    SimulationQuality quality_;                  ///< Quality the updates run at
+    double phase_ = 0;                           ///< Last phase given by nextPhase()
     std::list<FoodGenerator*> food_generator_;   ///< List of all food generators in the environment
     std::list<OrganicEntity*> kill_list_;         ///< List of entities marked for deletion
     std::list<Wave*> env_list_waves_;            ///< List of all waves in the environment
     std::list<Rock*> env_list_rocks_;            ///< List of all rocks in the environment
     std::list<CircularCollider*> env_list_obstacles_; ///< List of all obstacles in the environment
+    mutable ObstacleGrid obstacle_grid_;          ///< Broad-phase over env_list_obstacles_
+
+    /**
+     * @brief Returns the obstacle grid, rebuilt first if obstacles changed
+     */
+    ObstacleGrid const& getObstacleGrid() const;
+
+    /**
+     * @brief Moves the entities passed to rebucket() to their bucket
+     */
+    void moveRebucketed();
+
+    /**
+     * @brief Takes an entity out of its bucket, if it is in one
+     */
+    void removeFromBucket(OrganicEntity* entity);
+
+    /**
+     * @brief Sorts organic_entity_ into the buckets again, in its order
+     */
+    void rebuildBuckets();
+
+    /**
+     * @brief Rebuilds the position arrays below from organic_entity_
+     */
+    void rebuildSightIndex();
+
+    /**
+     * @brief Runs an animal's view cone over the moving entities
+     *
+     * On a tile (see WorldTiles) goes through the entities of the tile.
+     * Otherwise goes through the animal's neighbour list when it has one
+     * worth using, through every moving entity if not.
+     *
+     * @param animal The animal looking
+     * @param candidates Set to the entities the cone was run over
+     * @param selected Set to the indices, into candidates, of the entities
+     *        in the cone
+     * @return Number of indices in selected; null entities and the animal
+     *         itself may be among them
+     */
+    std::size_t selectMovingInSight(Animal const* animal, OrganicEntity* const*& candidates,
+                                    std::uint32_t const*& selected) const;
+
+    /**
+     * @brief Distributes the ticked entities over the tiles and perceives,
+     *        tile by tile on the worker threads, for the animals due to
+     *        perceive this tick
+     */
+    void perceiveInTiles();
+
+    /**
+     * @brief Updates the entities tile by tile on the worker threads, one
+     *        loop per bucket on each tile, then applies what the tiles
+     *        deferred (see defer())
+     *
+     * The tiles' steering batches are integrated on their threads, and
+     * left to applySteering(). SERIAL_BUCKET is not updated.
+     *
+     * @param dt Time elapsed since the last update of the entities
+     */
+    void updateInTiles(sf::Time dt);
+
+    /**
+     * @brief Gives the animals of an integrated steering batch their new
+     *        state, in the order they were pushed, and clears it
+     */
+    void applySteering(SteeringBatch& steering, sf::Time dt);
+
+    /**
+     * @brief Tells whether the distances around the torus to everything an
+     *        animal sees are the plain ones, i.e. whether its view distance
+     *        is at most half the world
+     */
+    bool seesPlainDistances(Animal const* animal) const;
+
+    // Positions of organic_entity_, same order, as arrays for the view cone kernel.
+    // Kept current during update(): each entity's slot is rewritten once it has moved.
+    std::vector<OrganicEntity*> sight_entities_;
+    std::vector<double> sight_x_;
+    std::vector<double> sight_y_;
+    std::vector<double> death_energy_;                  ///< energies of organic_entity_ once it has moved
+    mutable std::vector<std::uint32_t> sight_selected_; ///< scratch buffer of the kernel
+    mutable NeighbourLists neighbours_;                 ///< Ticked entities around each animal
+    WorldTiles tiles_;                                  ///< Tiles updated in parallel, when enabled
 };
\ No newline at end of file
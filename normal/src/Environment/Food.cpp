@@ -3,54 +3,45 @@
 #include "../Utility/Utility.hpp"
 #include "../Utility/Vec2d.hpp"
 #include "OrganicEntity.hpp"
+#include "Environment.hpp"
 
 
-Food::Food(const Vec2d& position ) : OrganicEntity(position,  getAppConfig().food_size,getAppConfig().food_energy) {}
+int const Food::EXPIRY;
 
-void Food::update(sf::Time )  {} 
-
-void Food::draw(sf::RenderTarget& targetWindow) const
+Food::Food(const Vec2d& position ) : OrganicEntity(position,  getAppConfig().food_size,getAppConfig().food_energy), expiry_(TimerWheel::NONE)
 {
-    if(isDebugOn()) CircularCollider::draw(targetWindow);
-    sf::Texture& texture = getAppTexture(getAppConfig().food_texture);
-    auto image_to_draw(buildSprite( getPosition(),
-                                    getRadius()*2,
-                                    texture ));
-
-    targetWindow.draw(image_to_draw );
-
+    species_ = Species::FOOD;
 }
-bool Food::eatable(OrganicEntity const* entity)  const
-{
 
-    return entity->eatableBy(this);
-}
-bool Food::eatableBy(Gerbil const* ) const
-{
-    return true;
-}
-bool Food::eatableBy(Food const* )  const
-{
-    return false;
-}
-bool Food::eatableBy(Scorpion const* )  const
+void Food::update(Environment&, sf::Time )  {} 
+
+void Food::scheduleTimers(Environment& env)
 {
-    return false;
+    // food doesn't age: its age is always the one it was added with
+    expiry_ = env.getTimers().schedule(getAgeLimit() - getAge(), this, EXPIRY);
 }
-bool Food::matable(OrganicEntity const* entity   ) const
-{
 
-    return entity->canMate(this);
-} 
-bool Food::canMate(Gerbil const* ) const
+void Food::onTimer(Environment& env, int kind)
 {
-    return false;
+    if (kind == EXPIRY) {
+        expiry_ = TimerWheel::NONE;
+        env.markForDeath(this);
+    }
 }
-bool Food::canMate(Food const* ) const
+
+void Food::cancelTimers(Environment& env)
 {
-    return false;
+    env.getTimers().cancel(expiry_);
 }
-bool Food::canMate(Scorpion const* ) const
+
+void Food::draw(sf::RenderTarget& targetWindow) const
 {
-    return false;
+    if(isDebugOn()) CircularCollider::draw(targetWindow);
+    sf::Texture& texture = getAppTexture(getAppConfig().food_texture);
+    auto image_to_draw(buildSprite( getPosition(),
+                                    getRadius()*2,
+                                    texture ));
+
+    targetWindow.draw(image_to_draw );
+
 }
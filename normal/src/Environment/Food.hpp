@@ -1,6 +1,7 @@
 #pragma once
 #include "../Utility/Vec2d.hpp"
 #include "OrganicEntity.hpp"
+#include "TimerWheel.hpp"
 
 class Scorpion;
 class Gerbil;
@@ -12,6 +13,10 @@ class Gerbil;
  * The Food class is a type of OrganicEntity that can be consumed by certain
  * entities (like Gerbil) but cannot consume other entities or mate.
  * It serves as a basic resource in the ecosystem.
+ *
+ * Food is static: the environment never updates it. It lies in the
+ * environment's StaticEntityGrid until it is eaten or, when its age limit
+ * is reached, expires through a timer.
  */
 class Food : public OrganicEntity
 {
@@ -24,76 +29,43 @@ public:
     
     /**
      * @brief Updates the Food entity state over time
+     *
+     * Does nothing, and isn't called by the environment: see isStatic().
+     *
+     * @param env Environment the food lies in
      * @param deltaTime Time elapsed since last update
      */
-    virtual void update(sf::Time deltaTime) override;
-    
-    /**
-     * @brief Renders the Food entity to the target window
-     * @param targetWindow The render target to draw the Food on
-     */
-    virtual void draw(sf::RenderTarget& targetWindow) const override;
-    
-    /**
-     * @brief Virtual destructor
-     */
-    ~Food() {}
+    virtual void update(Environment& env, sf::Time deltaTime) override;
 
     /**
-     * @brief Determines if the Food is eatable by a Gerbil
-     * @param gerbil Pointer to the Gerbil entity
-     * @return true if the Food can be eaten by Gerbil, false otherwise
-     */
-    bool eatableBy(Gerbil const* gerbil) const override;
-    
-    /**
-     * @brief Determines if the Food is eatable by another Food
-     * @param food Pointer to the Food entity
-     * @return Always false as Food cannot be eaten by other Food
+     * @brief Schedules the expiry of the food at its age limit
+     * @param env Environment the food was added to
      */
-    bool eatableBy(Food const* food) const override;
-    
-    /**
-     * @brief Determines if the Food is eatable by a Scorpion
-     * @param scorpion Pointer to the Scorpion entity
-     * @return Always false as Food cannot be eaten by Scorpion
-     */
-    bool eatableBy(Scorpion const* scorpion) const override;
-    
-    /**
-     * @brief Determines if an entity can be eaten by this Food
-     * @param entity Pointer to an OrganicEntity
-     * @return Always false as Food does not eat other entities
-     */
-    bool eatable(OrganicEntity const* entity) const override;
+    void scheduleTimers(Environment& env) override;
 
     /**
-     * @brief Determines if the Food can mate with a Gerbil
-     * @param gerbil Pointer to the Gerbil entity
-     * @return Always false as Food cannot mate
+     * @brief Reports the expired food to the environment
+     * @param env Environment the food lies in
+     * @param kind EXPIRY
      */
-    bool canMate(Gerbil const* gerbil) const override;
-    
+    void onTimer(Environment& env, int kind) override;
+
     /**
-     * @brief Determines if the Food can mate with another Food
-     * @param food Pointer to the Food entity
-     * @return Always false as Food cannot mate
+     * @brief Cancels the expiry of eaten food
+     * @param env Environment holding the timers
      */
-    bool canMate(Food const* food) const override;
+    void cancelTimers(Environment& env) override;
     
     /**
-     * @brief Determines if the Food can mate with a Scorpion
-     * @param scorpion Pointer to the Scorpion entity
-     * @return Always false as Food cannot mate
+     * @brief Renders the Food entity to the target window
+     * @param targetWindow The render target to draw the Food on
      */
-    bool canMate(Scorpion const* scorpion) const override;
+    virtual void draw(sf::RenderTarget& targetWindow) const override;
     
     /**
-     * @brief Determines if an entity can mate with this Food
-     * @param organicentity Pointer to an OrganicEntity
-     * @return Always false as Food cannot mate
+     * @brief Virtual destructor
      */
-    bool matable(OrganicEntity const* organicentity) const override;
+    ~Food() {}
 
     /**
      * @brief Checks if this entity is a Gerbil
@@ -121,4 +93,17 @@ public:
     {
         return true;
     }
+
+    bool isStatic() const override
+    {
+        return true;
+    }
+
+    /**
+     * @brief Kind of the only timer of food
+     */
+    static int const EXPIRY = 0;
+
+private:
+    TimerWheel::Handle expiry_;
 };
\ No newline at end of file
@@ -1,4 +1,7 @@
 #pragma once
+#include <SFML/System.hpp>
+
+class Environment;
 
 /**
  * @class FoodGenerator
@@ -25,9 +28,10 @@ public:
      * Food is spawned according to a normal distribution centered
      * in the simulation world.
      * 
+     * @param env Environment receiving the food
      * @param dt Time elapsed since the last update
      */
-    void update(sf::Time dt);
+    void update(Environment& env, sf::Time dt);
     
     /**
      * @brief Virtual destructor
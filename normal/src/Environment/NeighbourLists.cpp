@@ -0,0 +1,255 @@
+#include "NeighbourLists.hpp"
+#include "OrganicEntity.hpp"
+#include <algorithm>
+#include <cmath>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace // anonymous
+{
+
+std::size_t const MAX_LOG = 64;          ///< log entries kept before forcing the rebuilds
+unsigned const MAX_MISSES = 8;           ///< at most 255 direct scans between two tries
+std::size_t const MAX_LIST_FRACTION = 8; ///< lists longer than 1/8 of the entities aren't kept
+
+/// Distance between two coordinates around the torus
+inline double torusDistance(double a, double b, double size)
+{
+    double const d(std::abs(a - b));
+    return std::min(d, size - d);
+}
+
+} // anonymous
+
+NeighbourLists::NeighbourLists()
+    : skin_(0)
+    , world_size_(0)
+    , drift_(0)
+    , log_start_(0)
+{
+}
+
+void NeighbourLists::setup(double skin, double worldSize)
+{
+    if (skin != skin_ or worldSize != world_size_) {
+        skin_ = skin;
+        world_size_ = worldSize;
+        lists_.clear();
+    }
+}
+
+bool NeighbourLists::gather(OrganicEntity const* owner, Vec2d const& position, double distance,
+                            OrganicEntity* const* entities, double const* xs, double const* ys,
+                            std::size_t count)
+{
+    List& list(lists_[owner]);
+    double const dx(torusDistance(position.x, list.x, world_size_));
+    double const dy(torusDistance(position.y, list.y, world_size_));
+    if (!list.built or list.logged < log_start_
+        or std::sqrt(dx * dx + dy * dy) + (drift_ - list.drift) > list.radius - distance) {
+        if (list.skipped > 0) {
+            --list.skipped;
+            return false;
+        }
+        if (list.built and list.uses == 1) {
+            // the last build cost a full scan for a single query
+            miss(list);
+            return false;
+        }
+        if (list.uses > 1) list.misses = 0;
+        build(list, owner, position, distance, entities, xs, ys, count);
+        if (list.entities.size() * MAX_LIST_FRACTION > count) {
+            // going through the list would cost more than the direct scan
+            miss(list);
+            return false;
+        }
+    } else {
+        ++list.uses;
+    }
+
+    // entities born after the build can't be in the list yet
+    entities_.assign(list.entities.begin(), list.entities.end());
+    for (std::size_t i(list.logged - log_start_); i < log_.size(); ++i) {
+        if (log_[i] != nullptr and log_[i] != owner) {
+            entities_.push_back(log_[i]);
+        }
+    }
+
+    xs_.resize(entities_.size());
+    ys_.resize(entities_.size());
+    for (std::size_t i(0); i < entities_.size(); ++i) {
+        Vec2d const& where(entities_[i]->getPosition());
+        xs_[i] = where.x;
+        ys_[i] = where.y;
+    }
+    return true;
+}
+
+void NeighbourLists::miss(List& list)
+{
+    list.misses = std::min(list.misses + 1, MAX_MISSES);
+    list.skipped = (1u << list.misses) - 1;
+    list.built = false;
+    list.uses = 0;
+    list.entities.clear();
+}
+
+void NeighbourLists::build(List& list, OrganicEntity const* owner, Vec2d const& position, double distance,
+                           OrganicEntity* const* entities, double const* xs, double const* ys,
+                           std::size_t count)
+{
+    list.x = position.x;
+    list.y = position.y;
+    list.radius = distance + skin_;
+    list.drift = drift_;
+    list.logged = log_start_ + log_.size();
+    list.built = true;
+    list.uses = 1;
+
+    selected_.resize(count);
+    std::size_t const found(selectAround(position, list.radius, xs, ys, count));
+    list.entities.resize(found);
+    std::size_t kept(0);
+    for (std::size_t i(0); i < found; ++i) {
+        OrganicEntity* const entity(entities[selected_[i]]);
+        list.entities[kept] = entity;
+        kept += entity != nullptr and entity != owner;
+    }
+    list.entities.resize(kept);
+}
+
+#ifdef __SSE2__
+
+std::size_t NeighbourLists::selectAround(Vec2d const& position, double radius,
+                                         double const* xs, double const* ys, std::size_t count)
+{
+    __m128d const px(_mm_set1_pd(position.x));
+    __m128d const py(_mm_set1_pd(position.y));
+    __m128d const r2(_mm_set1_pd(radius * radius));
+    __m128d const world(_mm_set1_pd(world_size_));
+    __m128d const sign(_mm_set1_pd(-0.0));
+
+    // Two positions per iteration, as in ViewCone::select()
+    auto lanes = [&](__m128d x, __m128d y) {
+        __m128d dx(_mm_andnot_pd(sign, _mm_sub_pd(x, px)));
+        __m128d dy(_mm_andnot_pd(sign, _mm_sub_pd(y, py)));
+        dx = _mm_min_pd(dx, _mm_sub_pd(world, dx));
+        dy = _mm_min_pd(dy, _mm_sub_pd(world, dy));
+        __m128d const d2(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)));
+        return _mm_movemask_pd(_mm_cmple_pd(d2, r2));
+    };
+
+    // a good part of the positions is selected: write every index and
+    // only count the selected ones, rather than branching
+    std::uint32_t* const selected(selected_.data());
+    std::size_t n(0);
+    std::size_t i(0);
+    for (; i + 1 < count; i += 2) {
+        int const mask(lanes(_mm_loadu_pd(xs + i), _mm_loadu_pd(ys + i)));
+        selected[n] = i;
+        n += mask & 1;
+        selected[n] = i + 1;
+        n += (mask >> 1) & 1;
+    }
+    if (i < count) {
+        selected[n] = i;
+        n += lanes(_mm_set1_pd(xs[i]), _mm_set1_pd(ys[i])) & 1;
+    }
+    return n;
+}
+
+#else
+
+std::size_t NeighbourLists::selectAround(Vec2d const& position, double radius,
+                                         double const* xs, double const* ys, std::size_t count)
+{
+    double const radiusSquared(radius * radius);
+    std::uint32_t* const selected(selected_.data());
+    std::size_t n(0);
+    for (std::size_t i(0); i < count; ++i) {
+        double const dx(torusDistance(xs[i], position.x, world_size_));
+        double const dy(torusDistance(ys[i], position.y, world_size_));
+        selected[n] = i;
+        n += dx * dx + dy * dy <= radiusSquared;
+    }
+    return n;
+}
+
+#endif
+
+std::vector<OrganicEntity*> const& NeighbourLists::getEntities() const
+{
+    return entities_;
+}
+
+std::vector<double> const& NeighbourLists::getXs() const
+{
+    return xs_;
+}
+
+std::vector<double> const& NeighbourLists::getYs() const
+{
+    return ys_;
+}
+
+void NeighbourLists::added(OrganicEntity* entity)
+{
+    if (!lists_.empty()) {
+        log_.push_back(entity);
+    }
+}
+
+void NeighbourLists::moved(double distance)
+{
+    drift_ += distance;
+}
+
+void NeighbourLists::forget(std::vector<OrganicEntity*> const& dead)
+{
+    if (dead.empty()) return;
+
+    auto const isDead = [&dead](OrganicEntity* entity) {
+        return std::binary_search(dead.begin(), dead.end(), entity);
+    };
+    for (auto entity : dead) {
+        lists_.erase(entity);
+    }
+    for (auto& owned : lists_) {
+        // a list only holds entities that were within its radius, and none
+        // has moved more than the drift since
+        List& list(owned.second);
+        if (!list.built) continue;
+        double const reach(list.radius + (drift_ - list.drift));
+        bool near(false);
+        for (auto entity : dead) {
+            double const dx(torusDistance(entity->getPosition().x, list.x, world_size_));
+            double const dy(torusDistance(entity->getPosition().y, list.y, world_size_));
+            near = near or dx * dx + dy * dy <= reach * reach;
+        }
+        if (near) {
+            list.entities.erase(std::remove_if(list.entities.begin(), list.entities.end(), isDead),
+                                list.entities.end());
+        }
+    }
+    for (auto& entity : log_) {
+        if (entity != nullptr and isDead(entity)) entity = nullptr;
+    }
+}
+
+void NeighbourLists::endTick()
+{
+    if (log_.size() > MAX_LOG) {
+        log_start_ += log_.size();
+        log_.clear();
+    }
+}
+
+void NeighbourLists::clear()
+{
+    lists_.clear();
+    log_start_ += log_.size();
+    log_.clear();
+    drift_ = 0;
+}
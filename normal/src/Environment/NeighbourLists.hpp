@@ -0,0 +1,152 @@
+#pragma once
+#include "../Utility/Vec2d.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class OrganicEntity;
+
+/**
+ * @class NeighbourLists
+ * @brief Verlet lists of the ticked entities each animal may see
+ *
+ * Instead of testing every ticked entity against an animal's view cone,
+ * the environment keeps, per animal, the list of the entities that were
+ * within its view distance plus a skin when the list was built. As long as
+ * the animal and the entities around it haven't moved more than the skin
+ * altogether, nothing outside the list can have come into view, and only
+ * the list needs testing.
+ *
+ * A list is rebuilt when the displacement of its owner plus the drift of
+ * the population since the build exceeds the skin. The drift is the sum,
+ * over the ticks, of the largest move made by any entity: it bounds how
+ * far an entity not tracked by the list may have come, which the moves of
+ * the tracked neighbours alone can't tell.
+ *
+ * Lists are built with distances around the torus, which are never longer
+ * than the plain distances the view cone uses: an entity crossing a border
+ * is already in the lists of the animals it may jump next to. Entities
+ * born after a list was built are appended to a short log that every query
+ * looks through until its owner's list is rebuilt. Dead entities are
+ * dropped from the lists and the log by forget().
+ *
+ * Lists only pay off when they are short compared to the population and
+ * used several times between two builds, i.e. when an animal looks around
+ * often compared to how fast the animals move (see the perception period).
+ * An animal whose lists aren't worth it scans every entity directly
+ * instead, for a number of queries doubling with each miss, then tries a
+ * list again.
+ */
+class NeighbourLists
+{
+public:
+    NeighbourLists();
+
+    NeighbourLists(const NeighbourLists&) = delete;
+    NeighbourLists& operator=(const NeighbourLists&) = delete;
+
+    /**
+     * @brief Sets the margin added to the view distance of the lists and
+     *        the size of the world; the lists are dropped if either changes
+     */
+    void setup(double skin, double worldSize);
+
+    /**
+     * @brief Gathers the entities an animal may see
+     *
+     * Rebuilds the owner's list from the given arrays if it may be stale.
+     * After the call, getEntities(), getXs() and getYs() hold the candidates
+     * (never the owner) and their current positions: those of the list in
+     * the order of the arrays, then those of the log.
+     *
+     * @param owner the animal looking
+     * @param position its position
+     * @param distance its view distance
+     * @param entities every ticked entity (null slots are skipped)
+     * @param xs their x coordinates
+     * @param ys their y coordinates
+     * @param count number of entities
+     * @return false if the owner has no list worth using: every entity of
+     *         the arrays is a candidate then
+     */
+    bool gather(OrganicEntity const* owner, Vec2d const& position, double distance,
+                       OrganicEntity* const* entities, double const* xs, double const* ys,
+                       std::size_t count);
+
+    std::vector<OrganicEntity*> const& getEntities() const;
+    std::vector<double> const& getXs() const;
+    std::vector<double> const& getYs() const;
+
+    /**
+     * @brief Records a newborn entity
+     */
+    void added(OrganicEntity* entity);
+
+    /**
+     * @brief Records the largest distance moved by an entity during a tick,
+     *        around the torus
+     */
+    void moved(double distance);
+
+    /**
+     * @brief Drops dead entities from the lists and the log
+     *
+     * @param dead the entities, sorted by address
+     */
+    void forget(std::vector<OrganicEntity*> const& dead);
+
+    /**
+     * @brief Empties the log when it gets long; the lists older than it
+     *        are rebuilt at their next query
+     */
+    void endTick();
+
+    /**
+     * @brief Forgets every list
+     */
+    void clear();
+
+private:
+    struct List
+    {
+        bool built = false;
+        double x = 0;                         ///< owner position at the build
+        double y = 0;
+        double radius = 0;                    ///< view distance plus skin at the build
+        double drift = 0;                     ///< drift_ at the build
+        std::uint64_t logged = 0;             ///< log entries seen by the build
+        unsigned uses = 0;                    ///< queries served since the build
+        unsigned misses = 0;                  ///< consecutive lists that weren't worth it
+        unsigned skipped = 0;                 ///< direct scans left before building again
+        std::vector<OrganicEntity*> entities; ///< ticked entities within radius
+    };
+
+    /**
+     * @brief Drops a list that wasn't worth it and sets the direct scans
+     *        to do before building it again
+     */
+    void miss(List& list);
+
+    /**
+     * @brief Writes to selected_ the indices of the positions within radius
+     *        of position around the torus, two at a time in SSE2 lanes
+     * @return number of indices written
+     */
+    std::size_t selectAround(Vec2d const& position, double radius,
+                             double const* xs, double const* ys, std::size_t count);
+
+    void build(List& list, OrganicEntity const* owner, Vec2d const& position, double distance,
+               OrganicEntity* const* entities, double const* xs, double const* ys, std::size_t count);
+
+    double skin_;
+    double world_size_;
+    double drift_;                    ///< sum of the largest moves of each tick
+    std::vector<OrganicEntity*> log_; ///< entities added since log_start_
+    std::uint64_t log_start_;         ///< number of entries logged before log_[0]
+    std::unordered_map<OrganicEntity const*, List> lists_;
+    std::vector<OrganicEntity*> entities_; ///< candidates of the last gather()
+    std::vector<double> xs_;
+    std::vector<double> ys_;
+    std::vector<std::uint32_t> selected_;  ///< scratch buffer of build()
+};
@@ -1,6 +1,8 @@
 #include "OrganicEntity.hpp"
 #include "../Application.hpp"
 #include "../Random/Normal.hpp"
+#include "EntityPool.hpp"
+#include "../Animal/Animal.hpp"
 
 double OrganicEntity::positiveNormal(double value, double variance)
 {
@@ -12,6 +14,16 @@ double OrganicEntity::positiveNormal(double value, double variance)
     }
 }
 
+void* OrganicEntity::operator new(std::size_t size)
+{
+    return EntityPool::allocate(size);
+}
+
+void OrganicEntity::operator delete(void* block)
+{
+    EntityPool::deallocate(block);
+}
+
 double  OrganicEntity::positiveNormal(double value)
 {
     return positiveNormal(value,value*value);
@@ -19,14 +31,27 @@ double  OrganicEntity::positiveNormal(double value)
 
 OrganicEntity::OrganicEntity( const Vec2d& position, const double& size , const double& energy) : CircularCollider(position,
             positiveNormal(size,size/15*size/15)
-                                                                                                                         ), energy_(energy),  age_(sf::Time::Zero),
-    age_limit_(sf::seconds(10000)), base_energy_consumption_(getAppConfig().animal_base_energy_consumption) {}
+                                                                                                                         ), energy_(energy),  birth_(sf::Time::Zero),
+    clock_(nullptr), end_of_life_(TimerWheel::NONE), age_limit_(sf::seconds(10000)), base_energy_consumption_(getAppConfig().animal_base_energy_consumption), species_(Species::INERT),
+      bucket_(NO_BUCKET), bucket_slot_(0) {}
 
-OrganicEntity::OrganicEntity( const OrganicEntity& OE ) : OrganicEntity( OE.getPosition(),OE.getRadius(),OE.energy_) {}
+OrganicEntity::OrganicEntity( const OrganicEntity& OE ) : OrganicEntity( OE.getPosition(),OE.getRadius(),OE.energy_)
+{
+    species_ = OE.species_;
+}
 
 OrganicEntity::OrganicEntity( const Vec2d& position, const double& size , const double& energy, const sf::Time& ageLimit)
-    : CircularCollider(position, size), energy_(energy),  age_(sf::Time::Zero), age_limit_(ageLimit), base_energy_consumption_(getAppConfig().animal_base_energy_consumption)
+    : CircularCollider(position, size), energy_(energy),  birth_(sf::Time::Zero),
+      clock_(nullptr), end_of_life_(TimerWheel::NONE), age_limit_(ageLimit), base_energy_consumption_(getAppConfig().animal_base_energy_consumption), species_(Species::INERT),
+      bucket_(NO_BUCKET), bucket_slot_(0)
+{
+}
+
+bool OrganicEntity::matable(OrganicEntity const* other) const
 {
+    // only animal species have MATE entries, so both entities are animals
+    return speciesMate(species_, other->species_)
+        and static_cast<Animal const*>(other)->canMate(*static_cast<Animal const*>(this));
 }
 
 const double& OrganicEntity::getEnergy() const
@@ -34,14 +59,38 @@ const double& OrganicEntity::getEnergy() const
     return energy_;
 }
 
-void OrganicEntity::update(sf::Time dt)
+void OrganicEntity::update(Environment&, sf::Time dt)
+{
+    birth_ -= dt;
+}
+
+sf::Time OrganicEntity::getAge() const
+{
+    return clock_ != nullptr ? clock_->getTime() - birth_ : -birth_;
+}
+
+std::size_t OrganicEntity::getBlockBytes() const
+{
+    // the block starts at the most derived object
+    return EntityPool::blockBytes(dynamic_cast<void const*>(this));
+}
+
+void OrganicEntity::enterWorld(TimerWheel& clock)
+{
+    sf::Time const age(getAge());
+    clock_ = &clock;
+    birth_ = clock.getTime() - age;
+    end_of_life_ = clock.schedule(age_limit_ - age, this, END_OF_LIFE);
+}
+
+void OrganicEntity::leaveWorld(TimerWheel& clock)
 {
-    age_ += dt;
+    clock.cancel(end_of_life_);
 }
 
-const sf::Time& OrganicEntity::getAge() const
+sf::Time OrganicEntity::getDeadline(TimerWheel::Handle handle) const
 {
-    return age_;
+    return clock_ != nullptr ? clock_->getDeadline(handle) : sf::Time::Zero;
 }
 const sf::Time& OrganicEntity::getAgeLimit() const
 {
@@ -1,14 +1,14 @@
 #pragma once
 
-#include "../Interface/Updatable.hpp"
 #include "../Obstacle/CircularCollider.hpp"
+#include "Species.hpp"
+#include "TimerWheel.hpp"
+#include <SFML/System.hpp>
 
 #include <list>
 
 class Animal;
-class Scorpion;
-class Food;
-class Gerbil;
+class Environment;
 
 /**
  * @class OrganicEntity
@@ -17,10 +17,10 @@ class Gerbil;
  * OrganicEntity serves as the foundation for all living beings in the simulation,
  * implementing common properties such as energy management, aging, and interaction
  * rules between different entity types. It extends CircularCollider for physical
- * representation and collision detection, and implements Updatable for simulation
- * lifecycle integration.
+ * representation and collision detection. It is updated with the Environment it
+ * lives in, so that it never has to look its world up globally.
  */
-class OrganicEntity : public CircularCollider, public Updatable
+class OrganicEntity : public CircularCollider
 {
 public:
     /**
@@ -66,6 +66,18 @@ public:
      */
     virtual ~OrganicEntity() { }
 
+    /**
+     * @brief Allocates entities from the active EntityPool
+     *
+     * Falls back to the heap when no environment is updating on this thread.
+     */
+    static void* operator new(std::size_t size);
+
+    /**
+     * @brief Gives an entity's memory back to where it was allocated
+     */
+    static void operator delete(void* block);
+
     /**
      * @brief Memory management function to forget parent entity
      */
@@ -75,7 +87,7 @@ public:
      * @brief Memory management function to forget child entity
      * @param child Pointer to child entity to forget
      */
-    virtual void forgetChild(OrganicEntity* child) {}
+    virtual void forgetChild(OrganicEntity* /*child*/) {}
     
     /**
      * @brief Memory management function for general cleanup
@@ -86,7 +98,23 @@ public:
      * @brief Clears any reference to a dying entity
      * @param entity Pointer to entity being removed from the simulation
      */
-    virtual void forgetEntity(OrganicEntity* entity) {}
+    virtual void forgetEntity(OrganicEntity* /*entity*/) {}
+
+    /**
+     * @brief Warns the entity that a predator has it in sight
+     */
+    virtual void alert() {}
+
+    /**
+     * @brief Part of the next update that only reads the world
+     *
+     * Called on every ticked entity before the updates when the world is
+     * split into tiles (see WorldTiles), possibly on another thread: it
+     * may change the entity itself, but nothing else.
+     *
+     * @param env Environment the entity lives in
+     */
+    virtual void prepareUpdate(Environment& /*env*/) {}
 
     /**
      * @brief Sets the energy level of the entity
@@ -96,9 +124,14 @@ public:
     
     /**
      * @brief Updates the entity state based on elapsed time
+     *
+     * The base implementation makes the entity older by dt. The environment
+     * doesn't call it: the ages of its entities follow its clock.
+     *
+     * @param env Environment the entity lives in
      * @param dt Time elapsed since last update
      */
-    virtual void update(sf::Time dt) = 0;
+    virtual void update(Environment& env, sf::Time dt) = 0;
     
     /**
      * @brief Renders the entity to the target window
@@ -114,9 +147,13 @@ public:
 
     /**
      * @brief Gets the current age of the entity
-     * @return Current age as a constant reference
+     *
+     * Derived from the entity's birth time and the clock of the environment
+     * it lives in, if it was added to one with enterWorld().
+     *
+     * @return Current age
      */
-    const sf::Time& getAge() const;
+    sf::Time getAge() const;
     
     /**
      * @brief Gets the maximum age limit of the entity
@@ -124,75 +161,70 @@ public:
      */
     const sf::Time& getAgeLimit() const;
 
-    // Interaction rules between entities
+    /**
+     * @brief Gets the species of the entity
+     * @return Tag indexing the tables of Species.hpp
+     */
+    Species getSpecies() const
+    {
+        return species_;
+    }
+
+    // Interaction rules between entities, looked up in SPECIES_INTERACTIONS
 
     /**
      * @brief Determines if this entity can mate with another entity
+     *
+     * The species must be able to breed together and the other entity must
+     * be ready to mate with this one (see Animal::canMate()).
+     *
      * @param other Pointer to another entity
      * @return true if mating is possible, false otherwise
      */
-    virtual bool matable(OrganicEntity const* other) const = 0;
-    
-    /**
-     * @brief Determines if this entity can mate with a Scorpion
-     * @param scorpion Pointer to a Scorpion entity
-     * @return true if mating is possible, false otherwise
-     */
-    virtual bool canMate(Scorpion const* scorpion) const = 0;
-    
-    /**
-     * @brief Determines if this entity can mate with a Gerbil
-     * @param gerbil Pointer to a Gerbil entity
-     * @return true if mating is possible, false otherwise
-     */
-    virtual bool canMate(Gerbil const* gerbil) const = 0;
-    
-    /**
-     * @brief Determines if this entity can mate with Food
-     * @param food Pointer to a Food entity
-     * @return true if mating is possible, false otherwise
-     */
-    virtual bool canMate(Food const* food) const = 0;
+    bool matable(OrganicEntity const* other) const;
 
     /**
      * @brief Determines if this entity can eat another entity
      * @param entity Pointer to another entity
      * @return true if this entity can eat the other, false otherwise
      */
-    virtual bool eatable(OrganicEntity const* entity) const = 0;
-    
+    bool eatable(OrganicEntity const* entity) const
+    {
+        return speciesEat(species_, entity->species_);
+    }
+
     /**
-     * @brief Determines if this entity can be eaten by a Scorpion
-     * @param scorpion Pointer to a Scorpion entity
-     * @return true if this entity can be eaten by Scorpion, false otherwise
+     * @brief Handles interaction when meeting another entity
+     * @param env Environment the entities live in
+     * @param other Pointer to the entity encountered
      */
-    virtual bool eatableBy(Scorpion const* scorpion) const = 0;
+    virtual void meet(Environment& /*env*/, OrganicEntity* /*other*/) {}
     
     /**
-     * @brief Determines if this entity can be eaten by a Gerbil
-     * @param gerbil Pointer to a Gerbil entity
-     * @return true if this entity can be eaten by Gerbil, false otherwise
+     * @brief Specialized handling for meeting an Animal
+     * @param env Environment the entities live in
+     * @param animal Pointer to the Animal encountered
      */
-    virtual bool eatableBy(Gerbil const* gerbil) const = 0;
-    
+    virtual void meetThis(Environment& /*env*/, Animal* /*animal*/) {}
+
     /**
-     * @brief Determines if this entity can be eaten by Food
-     * @param food Pointer to a Food entity
-     * @return true if this entity can be eaten by Food, false otherwise
+     * @brief Receives a timer the entity scheduled on the environment's TimerWheel
+     * @param env Environment the entity lives in
+     * @param kind Kind given when the timer was scheduled
      */
-    virtual bool eatableBy(Food const* food) const = 0;
-    
+    virtual void onTimer(Environment& /*env*/, int /*kind*/) {}
+
     /**
-     * @brief Handles interaction when meeting another entity
-     * @param other Pointer to the entity encountered
+     * @brief Schedules the timers the entity needs once added to an environment
+     * @param env Environment the entity was added to
      */
-    virtual void meet(OrganicEntity* other) {}
-    
+    virtual void scheduleTimers(Environment& /*env*/) {}
+
     /**
-     * @brief Specialized handling for meeting an Animal
-     * @param animal Pointer to the Animal encountered
+     * @brief Cancels the entity's pending timers before it is removed
+     * @param env Environment holding the timers
      */
-    virtual void meetThis(Animal* animal) {}
+    virtual void cancelTimers(Environment& /*env*/) {}
 
     /**
      * @brief Checks if this entity is a Gerbil
@@ -212,16 +244,120 @@ public:
      */
     virtual bool isFood() const = 0;
 
+    /**
+     * @brief Checks if this entity never moves nor changes by itself
+     *
+     * Static entities are not updated every tick: the environment keeps them
+     * in a spatial index and they must report their own end through
+     * Environment::markForDeath().
+     *
+     * @return true for static entities, false by default
+     */
+    virtual bool isStatic() const
+    {
+        return false;
+    }
+
+    /**
+     * @brief Kind of the timer enterWorld() schedules; the environment
+     *        handles it and never passes it to onTimer()
+     */
+    static int const END_OF_LIFE = -1;
+
+    /**
+     * @brief Ties the entity's age to the clock of an environment, and
+     *        schedules its end of life there for when it reaches its age
+     *        limit
+     *
+     * The age the entity had so far is kept.
+     */
+    void enterWorld(TimerWheel& clock);
+
+    /**
+     * @brief Cancels the end of life scheduled by enterWorld()
+     */
+    void leaveWorld(TimerWheel& clock);
+
+    /**
+     * @brief Bytes the entity allocated on the heap for itself (lists...)
+     */
+    virtual std::size_t getHeapBytes() const
+    {
+        return 0;
+    }
+
+    /**
+     * @brief Bytes of the memory block of the entity (see EntityPool)
+     *
+     * Only for entities created with new, which all entities of an
+     * environment are.
+     */
+    std::size_t getBlockBytes() const;
+
+    /**
+     * @brief Update buckets of the ticked entities
+     *
+     * The environment keeps the ticked entities sorted into these buckets,
+     * moving them when their bucket changes (see Environment::rebucket()),
+     * and updates each bucket with its own loop.
+     */
+    enum UpdateBucket : std::uint8_t {
+        ACTIVE_BUCKET,    ///< updated with update()
+        WANDERING_BUCKET, ///< updated with wander()
+        HOLDING_BUCKET,   ///< updated with hold()
+        SERIAL_BUCKET,    ///< updated with update(), never on a tile (see WorldTiles)
+        UPDATE_BUCKETS,
+        NO_BUCKET = UPDATE_BUCKETS ///< not (yet) sorted into a bucket
+    };
+
+    /**
+     * @brief Bucket the entity belongs to in its current state
+     * @return ACTIVE_BUCKET by default
+     */
+    virtual UpdateBucket getUpdateBucket() const
+    {
+        return ACTIVE_BUCKET;
+    }
+
+    /**
+     * @brief Update of the entities of WANDERING_BUCKET
+     *
+     * Same as update() by default.
+     */
+    virtual void wander(Environment& env, sf::Time dt)
+    {
+        update(env, dt);
+    }
+
+    /**
+     * @brief Update of the entities of HOLDING_BUCKET, which only wait for
+     *        one of their timers
+     *
+     * Same as update() by default.
+     */
+    virtual void hold(Environment& env, sf::Time dt)
+    {
+        update(env, dt);
+    }
+
 protected:
+    /**
+     * @brief Time a timer of the entity's clock fires at, or zero if it
+     *        isn't pending or the entity has no clock (see enterWorld())
+     */
+    sf::Time getDeadline(TimerWheel::Handle handle) const;
+
     /**
      * @brief Handles reproduction to create new entities
+     * @param env Environment receiving the newborns
      */
-    virtual void giveBirth() {}
+    virtual void giveBirth(Environment& /*env*/) {}
     
     /**
      * @brief Specialized handling for reproduction
+     * @param env Environment receiving the newborns
      */
-    virtual void giveBirthThis() {}
+    virtual void giveBirthThis(Environment& /*env*/) {}
     
     /**
      * @brief Updates entity energy based on time and activity
@@ -233,7 +369,7 @@ protected:
      * @brief Adds a child entity to this entity's memory
      * @param child Pointer to the child entity
      */
-    virtual void addKidMemory(OrganicEntity* child) {}
+    virtual void addKidMemory(OrganicEntity* /*child*/) {}
 
     /**
      * @brief Current energy level of the entity
@@ -241,9 +377,20 @@ protected:
     double energy_;
 
     /**
-     * @brief Current age of the entity
+     * @brief Time of the clock at which the entity was born (negative of its
+     *        age when it has no clock)
      */
-    sf::Time age_;
+    sf::Time birth_;
+
+    /**
+     * @brief Clock of the environment the entity lives in, if any
+     */
+    TimerWheel const* clock_;
+
+    /**
+     * @brief End of life scheduled by enterWorld()
+     */
+    TimerWheel::Handle end_of_life_;
     
     /**
      * @brief Maximum age the entity can reach
@@ -254,4 +401,14 @@ protected:
      * @brief Base rate of energy consumption per time unit
      */
     double base_energy_consumption_;
+
+    /**
+     * @brief Species of the entity, set by the constructors of each species
+     */
+    Species species_;
+
+    // where the environment keeps the entity, see Environment::rebucket()
+    friend class Environment;
+    UpdateBucket bucket_;      ///< bucket the entity is in
+    std::uint32_t bucket_slot_; ///< index of the entity in its bucket
 };
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "SpatialOrder.hpp"
+#include "OrganicEntity.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace // anonymous
+{
+
+std::uint32_t const SIDE = 1u << 16; ///< cells per side of the curve
+
+/// Cell of a coordinate along one side of the curve
+std::uint32_t cellOf(double coordinate, double worldSize)
+{
+    double const cell(std::floor(coordinate / worldSize * SIDE));
+    return static_cast<std::uint32_t>(std::max(0.0, std::min<double>(SIDE - 1, cell)));
+}
+
+} // anonymous
+
+SpatialOrder::SpatialOrder()
+    : threshold_(0)
+    , baseline_(0)
+    , due_(true)
+    , sorts_(0)
+{
+}
+
+void SpatialOrder::setup(double threshold)
+{
+    threshold_ = threshold;
+}
+
+void SpatialOrder::observe(double const* xs, double const* ys, std::size_t count, double worldSize)
+{
+    if (count < 2) return;
+
+    double sum(0);
+    for (std::size_t i(1); i < count; ++i) {
+        double dx(std::abs(xs[i] - xs[i - 1]));
+        double dy(std::abs(ys[i] - ys[i - 1]));
+        dx = std::min(dx, worldSize - dx);
+        dy = std::min(dy, worldSize - dy);
+        sum += std::sqrt(dx * dx + dy * dy);
+    }
+    double const spread(sum / (count - 1));
+
+    if (baseline_ == 0) {
+        baseline_ = spread;
+    } else {
+        due_ = due_ or spread > threshold_ * baseline_;
+    }
+}
+
+bool SpatialOrder::due() const
+{
+    return threshold_ > 0 and due_;
+}
+
+void SpatialOrder::sort(std::list<OrganicEntity*>& entities, double worldSize)
+{
+    keyed_.clear();
+    for (auto entity : entities) {
+        std::uint32_t const k(entity != nullptr
+                              ? key(entity->getPosition().x, entity->getPosition().y, worldSize)
+                              : std::numeric_limits<std::uint32_t>::max());
+        keyed_.emplace_back(k, entity);
+    }
+    // stable, so that entities sharing a cell keep their relative order
+    std::stable_sort(keyed_.begin(), keyed_.end(),
+    [](std::pair<std::uint32_t, OrganicEntity*> const& a, std::pair<std::uint32_t, OrganicEntity*> const& b) {
+        return a.first < b.first;
+    });
+
+    auto slot(entities.begin());
+    for (auto const& k : keyed_) {
+        *slot++ = k.second;
+    }
+
+    baseline_ = 0;
+    due_ = false;
+    ++sorts_;
+}
+
+void SpatialOrder::clear()
+{
+    baseline_ = 0;
+    due_ = true;
+}
+
+std::size_t SpatialOrder::getSorts() const
+{
+    return sorts_;
+}
+
+std::uint32_t SpatialOrder::key(double x, double y, double worldSize)
+{
+    std::uint32_t cx(cellOf(x, worldSize));
+    std::uint32_t cy(cellOf(y, worldSize));
+    std::uint32_t d(0);
+    for (std::uint32_t s(SIDE / 2); s > 0; s /= 2) {
+        std::uint32_t const rx((cx & s) > 0);
+        std::uint32_t const ry((cy & s) > 0);
+        d += s * s * ((3 * rx) ^ ry);
+        // rotate the quadrant so that the curve stays continuous
+        if (ry == 0) {
+            if (rx == 1) {
+                cx = SIDE - 1 - cx;
+                cy = SIDE - 1 - cy;
+            }
+            std::swap(cx, cy);
+        }
+    }
+    return d;
+}
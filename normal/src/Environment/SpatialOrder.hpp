@@ -0,0 +1,85 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <utility>
+#include <vector>
+
+class OrganicEntity;
+
+/**
+ * @class SpatialOrder
+ * @brief Keeps the ticked entities stored in the order of a Hilbert curve
+ *
+ * Entities are appended as they are born and move independently, so the
+ * order of the environment's list soon has nothing to do with where they
+ * are: the sight arrays, the neighbour lists and the steering batch, all
+ * built in that order, then jump around memory from one entity to the
+ * next. Sorting the list by the Hilbert key of the positions puts
+ * entities that are close in space next to each other again.
+ *
+ * Only the list is reordered: the entities themselves stay where they were
+ * allocated, so every pointer to them held elsewhere remains valid.
+ *
+ * The trigger is adaptive. The spread of the order, the mean distance
+ * between consecutive entities, is cheap to measure from the sight arrays
+ * and grows as the order decays: a sort is due once it exceeds threshold
+ * times the spread measured just after the last sort.
+ */
+class SpatialOrder
+{
+public:
+    SpatialOrder();
+
+    SpatialOrder(const SpatialOrder&) = delete;
+    SpatialOrder& operator=(const SpatialOrder&) = delete;
+
+    /**
+     * @brief Sets how much the spread may grow before a sort, as a factor
+     *        of its value after the last one; 0 never sorts
+     */
+    void setup(double threshold);
+
+    /**
+     * @brief Measures the spread of the current order
+     *
+     * @param xs x coordinates of the entities, in storage order
+     * @param ys their y coordinates
+     * @param count number of entities
+     * @param worldSize side of the (toric) world
+     */
+    void observe(double const* xs, double const* ys, std::size_t count, double worldSize);
+
+    /**
+     * @brief Tells whether the order decayed enough to be sorted again
+     */
+    bool due() const;
+
+    /**
+     * @brief Sorts the entities along the curve; null entries go last
+     */
+    void sort(std::list<OrganicEntity*>& entities, double worldSize);
+
+    /**
+     * @brief Forgets the measures and makes a sort due
+     */
+    void clear();
+
+    /**
+     * @brief Number of sorts done so far
+     */
+    std::size_t getSorts() const;
+
+    /**
+     * @brief Position of a point along the Hilbert curve filling the world,
+     *        at a resolution of 2^16 cells per side
+     */
+    static std::uint32_t key(double x, double y, double worldSize);
+
+private:
+    double threshold_;
+    double baseline_;       ///< spread measured after the last sort, 0 if not yet measured
+    bool due_;
+    std::size_t sorts_;
+    std::vector<std::pair<std::uint32_t, OrganicEntity*>> keyed_; ///< scratch buffer of sort()
+};
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "../Config.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Tag telling which species an OrganicEntity belongs to
+ *
+ * INERT is the species of entities taking part in no interaction. COUNT is
+ * the number of species, not a species.
+ */
+enum class Species : std::uint8_t { INERT, FOOD, GERBIL, SCORPION, COUNT };
+
+/**
+ * @brief Number of species in the interaction tables
+ */
+constexpr std::size_t SPECIES_COUNT(static_cast<std::size_t>(Species::COUNT));
+
+/**
+ * @brief Flags describing how an entity sees another one
+ *
+ * Each row of SPECIES_INTERACTIONS tells an entity of the row's species
+ * whether an entity of the column's species is its PREY, its PREDATOR or a
+ * possible MATE. Adding a species means adding a row and a column here and
+ * a line to SPECIES_PARAMETERS.
+ */
+enum Interaction : std::uint8_t {
+    NO_INTERACTION = 0,
+    PREY           = 1 << 0,
+    PREDATOR       = 1 << 1,
+    MATE           = 1 << 2
+};
+
+/**
+ * @brief Interactions between species, indexed [observer][observed]
+ */
+constexpr std::uint8_t SPECIES_INTERACTIONS[SPECIES_COUNT][SPECIES_COUNT] = {
+    //                INERT           FOOD            GERBIL          SCORPION
+    /* INERT    */ { NO_INTERACTION, NO_INTERACTION, NO_INTERACTION, NO_INTERACTION },
+    /* FOOD     */ { NO_INTERACTION, NO_INTERACTION, PREDATOR,       NO_INTERACTION },
+    /* GERBIL   */ { NO_INTERACTION, PREY,           MATE,           PREDATOR       },
+    /* SCORPION */ { NO_INTERACTION, NO_INTERACTION, PREY,           MATE           },
+};
+
+/**
+ * @brief Gives the interactions an observer has with an observed entity
+ * @param observer Species of the entity looking
+ * @param observed Species of the entity looked at
+ * @return Combination of Interaction flags
+ */
+constexpr std::uint8_t interaction(Species observer, Species observed)
+{
+    return SPECIES_INTERACTIONS[static_cast<std::size_t>(observer)]
+                               [static_cast<std::size_t>(observed)];
+}
+
+/**
+ * @brief Tells whether a species eats another one
+ * @param predator Species of the eater
+ * @param prey Species of the eaten
+ * @return true if predator eats prey
+ */
+constexpr bool speciesEat(Species predator, Species prey)
+{
+    return (interaction(predator, prey) & PREY) != 0;
+}
+
+/**
+ * @brief Tells whether two species can breed together
+ * @param first Species of one partner
+ * @param second Species of the other partner
+ * @return true if they can mate
+ */
+constexpr bool speciesMate(Species first, Species second)
+{
+    return (interaction(first, second) & MATE) != 0;
+}
+
+/**
+ * @brief Checks that SPECIES_INTERACTIONS agrees with itself
+ *
+ * Every PREY must see its eater as a PREDATOR, and MATE must be symmetric.
+ *
+ * @param cell Index of the first cell to check, row by row
+ * @return true if the table is consistent
+ */
+constexpr bool interactionsConsistent(std::size_t cell = 0)
+{
+    return cell == SPECIES_COUNT * SPECIES_COUNT
+        or (((SPECIES_INTERACTIONS[cell / SPECIES_COUNT][cell % SPECIES_COUNT] & PREY) != 0)
+            == ((SPECIES_INTERACTIONS[cell % SPECIES_COUNT][cell / SPECIES_COUNT] & PREDATOR) != 0)
+            and (SPECIES_INTERACTIONS[cell / SPECIES_COUNT][cell % SPECIES_COUNT] & MATE)
+            == (SPECIES_INTERACTIONS[cell % SPECIES_COUNT][cell / SPECIES_COUNT] & MATE)
+            and interactionsConsistent(cell + 1));
+}
+
+static_assert(interactionsConsistent(), "SPECIES_INTERACTIONS must pair every PREY with a PREDATOR");
+static_assert(speciesEat(Species::GERBIL, Species::FOOD) and speciesEat(Species::SCORPION, Species::GERBIL),
+              "the food chain goes food, gerbil, scorpion");
+
+/**
+ * @brief Per species configuration of mating
+ *
+ * The values live in the Config: the table only tells which of its members
+ * apply to each species, so that fertility is checked by one function for
+ * all animals.
+ */
+struct SpeciesParameters {
+    const double Config::* min_age_mating;           ///< Age in seconds from which the species mates
+    const double Config::* energy_min_mating_female; ///< Energy a female needs to mate
+    const double Config::* energy_min_mating_male;   ///< Energy a male needs to mate
+};
+
+/**
+ * @brief Mating parameters of each species, indexed by Species
+ *
+ * Species that don't mate have null members.
+ */
+constexpr SpeciesParameters SPECIES_PARAMETERS[SPECIES_COUNT] = {
+    /* INERT    */ { nullptr, nullptr, nullptr },
+    /* FOOD     */ { nullptr, nullptr, nullptr },
+    /* GERBIL   */ { &Config::gerbil_min_age_mating,
+                     &Config::gerbil_energy_min_mating_female,
+                     &Config::gerbil_energy_min_mating_male },
+    /* SCORPION */ { &Config::scorpion_min_age_mating,
+                     &Config::scorpion_energy_min_mating_female,
+                     &Config::scorpion_energy_min_mating_male },
+};
+
+/**
+ * @brief Gives the mating parameters of a species
+ * @param species Species looked up
+ * @return Its line of SPECIES_PARAMETERS
+ */
+constexpr SpeciesParameters const& speciesParameters(Species species)
+{
+    return SPECIES_PARAMETERS[static_cast<std::size_t>(species)];
+}
@@ -0,0 +1,92 @@
+#include "StaticEntityGrid.hpp"
+#include "OrganicEntity.hpp"
+#include "../Application.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace // anonymous
+{
+
+double const CELL_SIZE = 250; ///< about half the usual view distances
+int const MAX_CELLS_PER_SIDE = 64;
+
+} // anonymous
+
+StaticEntityGrid::StaticEntityGrid()
+    : cells_per_side_(0)
+    , cell_size_(CELL_SIZE)
+{
+}
+
+void StaticEntityGrid::layout()
+{
+    double const worldSize(getAppConfig().simulation_world_size);
+    cells_per_side_ = std::max(1, std::min(MAX_CELLS_PER_SIDE, static_cast<int>(std::ceil(worldSize / CELL_SIZE))));
+    cell_size_ = worldSize / cells_per_side_;
+    cells_.assign(cells_per_side_ * cells_per_side_, Cell());
+}
+
+int StaticEntityGrid::cellOf(double coordinate) const
+{
+    int const cell(static_cast<int>(std::floor(coordinate / cell_size_)));
+    return std::max(0, std::min(cells_per_side_ - 1, cell));
+}
+
+void StaticEntityGrid::cellRange(double low, double high, int& first, int& last) const
+{
+    first = cellOf(low);
+    last = cellOf(high);
+}
+
+void StaticEntityGrid::insert(OrganicEntity* entity)
+{
+    if (entity == nullptr or contains(entity)) return;
+    if (cells_.empty()) layout();
+
+    Vec2d const& position(entity->getPosition());
+    std::uint32_t const cellIndex(cellOf(position.y) * cells_per_side_ + cellOf(position.x));
+    Cell& cell(cells_[cellIndex]);
+    slots_[entity] = { cellIndex, static_cast<std::uint32_t>(cell.entities.size()) };
+    cell.entities.push_back(entity);
+    cell.xs.push_back(position.x);
+    cell.ys.push_back(position.y);
+}
+
+bool StaticEntityGrid::remove(OrganicEntity* entity)
+{
+    auto const found(slots_.find(entity));
+    if (found == slots_.end()) return false;
+
+    Slot const slot(found->second);
+    slots_.erase(found);
+
+    // the last entity of the cell takes the freed place
+    Cell& cell(cells_[slot.cell]);
+    std::uint32_t const last(cell.entities.size() - 1);
+    if (slot.index != last) {
+        cell.entities[slot.index] = cell.entities[last];
+        cell.xs[slot.index] = cell.xs[last];
+        cell.ys[slot.index] = cell.ys[last];
+        slots_[cell.entities[slot.index]].index = slot.index;
+    }
+    cell.entities.pop_back();
+    cell.xs.pop_back();
+    cell.ys.pop_back();
+    return true;
+}
+
+bool StaticEntityGrid::contains(OrganicEntity const* entity) const
+{
+    return slots_.count(entity) != 0;
+}
+
+std::size_t StaticEntityGrid::size() const
+{
+    return slots_.size();
+}
+
+void StaticEntityGrid::clear()
+{
+    cells_.clear();
+    slots_.clear();
+}
@@ -0,0 +1,205 @@
+#pragma once
+#include "../Animal/ViewCone.hpp"
+#include "../Utility/Vec2d.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class OrganicEntity;
+
+/**
+ * @class StaticEntityGrid
+ * @brief Spatial index of the entities that never move (food)
+ *
+ * Static entities are kept apart from the ticked ones: they are not
+ * updated, do not age and are only looked at when an animal searches its
+ * surroundings. The world is cut into square cells, each holding the
+ * positions of its entities as arrays, so that a view cone only tests the
+ * cells under its bounding box, with the batched ViewCone::select().
+ *
+ * The grid changes only when an entity is inserted (spawn) or removed
+ * (consumption, expiry).
+ */
+class StaticEntityGrid
+{
+public:
+    StaticEntityGrid();
+
+    StaticEntityGrid(const StaticEntityGrid&) = delete;
+    StaticEntityGrid& operator=(const StaticEntityGrid&) = delete;
+
+    /**
+     * @brief Adds an entity at its current position
+     */
+    void insert(OrganicEntity* entity);
+
+    /**
+     * @brief Removes an entity; does nothing if it isn't in the grid
+     *
+     * @return true if the entity was in the grid
+     */
+    bool remove(OrganicEntity* entity);
+
+    /**
+     * @brief Tells whether an entity is in the grid
+     */
+    bool contains(OrganicEntity const* entity) const;
+
+    /**
+     * @brief Number of entities in the grid
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Forgets every entity (without deleting them)
+     */
+    void clear();
+
+    /**
+     * @brief Calls f on every entity
+     */
+    template <typename F>
+    void forEach(F f) const
+    {
+        for (auto const& cell : cells_) {
+            for (auto entity : cell.entities) {
+                f(entity);
+            }
+        }
+    }
+
+    /**
+     * @brief Calls f on every entity inside a view cone
+     *
+     * @param cone the view cone
+     * @param origin apex of the cone
+     * @param distance length of the cone
+     * @param f callable taking an OrganicEntity*
+     * @param scratch buffer for the indices selected by the cone, for the
+     *        callers querying from several threads; the grid's own if null
+     */
+    template <typename F>
+    void forEachInCone(ViewCone const& cone, Vec2d const& origin, double distance, F f,
+                       std::vector<std::uint32_t>* scratch = nullptr) const
+    {
+        if (cells_.empty()) return;
+        std::vector<std::uint32_t>& selected(scratch != nullptr ? *scratch : selected_);
+
+        int firstColumn, lastColumn, firstRow, lastRow;
+        cellRange(origin.x - distance, origin.x + distance, firstColumn, lastColumn);
+        cellRange(origin.y - distance, origin.y + distance, firstRow, lastRow);
+        for (int row(firstRow); row <= lastRow; ++row) {
+            for (int column(firstColumn); column <= lastColumn; ++column) {
+                Cell const& cell(cells_[row * cells_per_side_ + column]);
+                std::size_t const count(cell.entities.size());
+                if (count == 0) continue;
+
+                selected.resize(std::max(selected.size(), count));
+                std::size_t const seen(cone.select(cell.xs.data(), cell.ys.data(), count, selected.data()));
+                for (std::size_t i(0); i < seen; ++i) {
+                    f(cell.entities[selected[i]]);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Finds the closest entity inside a view cone, ring by ring
+     *
+     * Visits the cells under the cone by rings of increasing distance from
+     * the origin's cell. The ring r (cells r steps away from it) can't hold
+     * anything closer to the origin than r - 1 cells: once an entity at
+     * most that far has been found, the search stops.
+     *
+     * @param cone the view cone
+     * @param origin apex of the cone
+     * @param distance length of the cone
+     * @param best distance of the closest entity found so far, updated
+     * @param stopEarly whether measure() is the plain distance to the origin
+     *        for the entities in the cone, which the rings bound
+     * @param measure callable giving the distance of an OrganicEntity* to
+     *        the origin, or a negative value if it doesn't qualify
+     * @param scratch as for forEachInCone()
+     * @return closest entity at a distance of at most best, or nullptr
+     */
+    template <typename F>
+    OrganicEntity* findClosestInCone(ViewCone const& cone, Vec2d const& origin, double distance,
+                                     double& best, bool stopEarly, F measure,
+                                     std::vector<std::uint32_t>* scratch = nullptr) const
+    {
+        if (cells_.empty()) return nullptr;
+        std::vector<std::uint32_t>& selected(scratch != nullptr ? *scratch : selected_);
+
+        int firstColumn, lastColumn, firstRow, lastRow;
+        cellRange(origin.x - distance, origin.x + distance, firstColumn, lastColumn);
+        cellRange(origin.y - distance, origin.y + distance, firstRow, lastRow);
+        int const column(cellOf(origin.x));
+        int const row(cellOf(origin.y));
+        int const rings(std::max(std::max(column - firstColumn, lastColumn - column),
+                                 std::max(row - firstRow, lastRow - row)));
+
+        OrganicEntity* closest(nullptr);
+        auto visit = [&](int r, int c) {
+            if (r < firstRow or r > lastRow or c < firstColumn or c > lastColumn) return;
+            Cell const& cell(cells_[r * cells_per_side_ + c]);
+            std::size_t const count(cell.entities.size());
+            if (count == 0) return;
+
+            selected.resize(std::max(selected.size(), count));
+            std::size_t const seen(cone.select(cell.xs.data(), cell.ys.data(), count, selected.data()));
+            for (std::size_t i(0); i < seen; ++i) {
+                OrganicEntity* const entity(cell.entities[selected[i]]);
+                double const d(measure(entity));
+                if (d >= 0 and d <= best) {
+                    best = d;
+                    closest = entity;
+                }
+            }
+        };
+        for (int ring(0); ring <= rings; ++ring) {
+            if (stopEarly and ring > 0 and best <= (ring - 1) * cell_size_) break;
+            for (int c(column - ring); c <= column + ring; ++c) {
+                visit(row - ring, c);
+                if (ring > 0) visit(row + ring, c);
+            }
+            for (int r(row - ring + 1); r <= row + ring - 1; ++r) {
+                visit(r, column - ring);
+                if (ring > 0) visit(r, column + ring);
+            }
+        }
+        return closest;
+    }
+
+private:
+    struct Cell
+    {
+        std::vector<OrganicEntity*> entities;
+        std::vector<double> xs;
+        std::vector<double> ys;
+    };
+
+    struct Slot
+    {
+        std::uint32_t cell;
+        std::uint32_t index; ///< in the cell's arrays
+    };
+
+    /**
+     * @brief Sets up the cells from the world size, on first insertion
+     */
+    void layout();
+
+    /**
+     * @brief Cells covered by [low, high] along one axis, clipped to the world
+     */
+    void cellRange(double low, double high, int& first, int& last) const;
+
+    int cellOf(double coordinate) const;
+
+    int cells_per_side_;
+    double cell_size_;
+    std::vector<Cell> cells_;
+    std::unordered_map<OrganicEntity const*, Slot> slots_;
+    mutable std::vector<std::uint32_t> selected_; ///< scratch buffer of the cone queries
+};
@@ -0,0 +1,35 @@
+#include "SubsystemClock.hpp"
+
+SubsystemClock::SubsystemClock()
+    : period_(sf::Time::Zero)
+    , accumulated_(sf::Time::Zero)
+{
+}
+
+void SubsystemClock::setPeriod(sf::Time period)
+{
+    period_ = period;
+}
+
+bool SubsystemClock::advance(sf::Time dt)
+{
+    accumulated_ += dt;
+    return due();
+}
+
+bool SubsystemClock::due() const
+{
+    return accumulated_ >= period_;
+}
+
+sf::Time SubsystemClock::consume()
+{
+    sf::Time const elapsed(accumulated_);
+    accumulated_ = sf::Time::Zero;
+    return elapsed;
+}
+
+void SubsystemClock::reset()
+{
+    accumulated_ = sf::Time::Zero;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <SFML/System.hpp>
+
+/**
+ * @class SubsystemClock
+ * @brief Runs a subsystem of the simulation at its own rate
+ *
+ * Every tick adds its dt to the clock; the subsystem only runs once the
+ * accumulated time reaches its period, and then runs with all of it, so
+ * that slow processes integrate exactly the time that went by while
+ * skipping the cost of the ticks in between. A period of zero runs the
+ * subsystem on every tick, with that tick's dt.
+ */
+class SubsystemClock
+{
+public:
+    SubsystemClock();
+
+    /**
+     * @brief Sets the period of the subsystem; zero runs it on every tick
+     */
+    void setPeriod(sf::Time period);
+
+    /**
+     * @brief Adds the dt of a tick
+     *
+     * @return true if the subsystem is due
+     */
+    bool advance(sf::Time dt);
+
+    /**
+     * @brief Tells whether the subsystem is due
+     */
+    bool due() const;
+
+    /**
+     * @brief Time to run the subsystem with, all of the time accumulated
+     *        since it last ran; restarts the accumulation
+     */
+    sf::Time consume();
+
+    /**
+     * @brief Forgets the accumulated time
+     */
+    void reset();
+
+private:
+    sf::Time period_;
+    sf::Time accumulated_;
+};
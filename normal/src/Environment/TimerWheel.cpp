@@ -0,0 +1,181 @@
+#include "TimerWheel.hpp"
+
+TimerWheel::Handle const TimerWheel::NONE;
+int const TimerWheel::LEVELS;
+int const TimerWheel::SLOT_BITS;
+std::uint64_t const TimerWheel::SLOTS;
+std::uint64_t const TimerWheel::SLOT_MASK;
+std::int32_t const TimerWheel::NIL;
+sf::Int64 const TimerWheel::MICROSECONDS_PER_TICK;
+
+namespace // anonymous
+{
+
+/// Handle of node index with the given generation; never NONE
+TimerWheel::Handle makeHandle(std::int32_t index, std::uint32_t generation)
+{
+    return (static_cast<TimerWheel::Handle>(generation) << 32) | (static_cast<std::uint32_t>(index) + 1);
+}
+
+std::int32_t indexOf(TimerWheel::Handle handle)
+{
+    return static_cast<std::int32_t>((handle & 0xFFFFFFFF) - 1);
+}
+
+std::uint32_t generationOf(TimerWheel::Handle handle)
+{
+    return static_cast<std::uint32_t>(handle >> 32);
+}
+
+} // anonymous
+
+TimerWheel::TimerWheel()
+    : time_(sf::Time::Zero)
+    , tick_(0)
+    , free_(NIL)
+    , size_(0)
+{
+    slots_.fill(NIL);
+}
+
+sf::Time TimerWheel::getTime() const
+{
+    return time_;
+}
+
+std::uint64_t TimerWheel::toTick(sf::Time time)
+{
+    return time > sf::Time::Zero ? time.asMicroseconds() / MICROSECONDS_PER_TICK : 0;
+}
+
+TimerWheel::Handle TimerWheel::schedule(sf::Time delay, OrganicEntity* owner, int kind)
+{
+    std::int32_t index;
+    if (free_ != NIL) {
+        index = free_;
+        free_ = nodes_[index].next;
+    } else {
+        index = static_cast<std::int32_t>(nodes_.size());
+        nodes_.push_back(Node());
+        nodes_[index].generation = 0;
+    }
+
+    // rounded up: a timer never fires early
+    std::int64_t const end((time_ + delay).asMicroseconds());
+    std::uint64_t const deadline(end > 0 ? (end + MICROSECONDS_PER_TICK - 1) / MICROSECONDS_PER_TICK : 0);
+
+    Node& node(nodes_[index]);
+    node.deadline = deadline > tick_ ? deadline : tick_ + 1;
+    node.owner = owner;
+    node.kind = kind;
+    insert(index);
+    ++size_;
+    return makeHandle(index, node.generation);
+}
+
+void TimerWheel::cancel(Handle& handle)
+{
+    if (isPending(handle)) {
+        std::int32_t const index(indexOf(handle));
+        unlink(index);
+        release(index);
+    }
+    handle = NONE;
+}
+
+bool TimerWheel::isPending(Handle handle) const
+{
+    if (handle == NONE) return false;
+    std::int32_t const index(indexOf(handle));
+    return index < static_cast<std::int32_t>(nodes_.size())
+           and nodes_[index].generation == generationOf(handle)
+           and nodes_[index].slot != NIL;
+}
+
+sf::Time TimerWheel::getDeadline(Handle handle) const
+{
+    if (!isPending(handle)) return sf::Time::Zero;
+    return sf::microseconds(nodes_[indexOf(handle)].deadline * MICROSECONDS_PER_TICK);
+}
+
+std::size_t TimerWheel::size() const
+{
+    return size_;
+}
+
+void TimerWheel::clear()
+{
+    slots_.fill(NIL);
+    free_ = NIL;
+    // keep the generations, so that handles held elsewhere stay stale
+    for (std::size_t i(nodes_.size()); i-- > 0;) {
+        Node& node(nodes_[i]);
+        if (node.slot != NIL) {
+            node.slot = NIL;
+            ++node.generation;
+        }
+        node.next = free_;
+        free_ = static_cast<std::int32_t>(i);
+    }
+    size_ = 0;
+}
+
+void TimerWheel::insert(std::int32_t index)
+{
+    Node& node(nodes_[index]);
+    std::uint64_t const delta(node.deadline - tick_);
+
+    int level(0);
+    while (level < LEVELS - 1 and delta >= (SLOTS << (SLOT_BITS * level))) {
+        ++level;
+    }
+    // beyond the top level: parked in the farthest slot, re-examined when spilled
+    std::uint64_t const span(SLOTS << (SLOT_BITS * level));
+    std::uint64_t const when(delta < span ? node.deadline : tick_ + span - 1);
+
+    std::int32_t const slot(level * SLOTS + ((when >> (SLOT_BITS * level)) & SLOT_MASK));
+    node.slot = slot;
+    node.previous = NIL;
+    node.next = slots_[slot];
+    if (node.next != NIL) nodes_[node.next].previous = index;
+    slots_[slot] = index;
+}
+
+void TimerWheel::unlink(std::int32_t index)
+{
+    Node& node(nodes_[index]);
+    if (node.previous != NIL) {
+        nodes_[node.previous].next = node.next;
+    } else {
+        slots_[node.slot] = node.next;
+    }
+    if (node.next != NIL) nodes_[node.next].previous = node.previous;
+    node.slot = NIL;
+}
+
+void TimerWheel::release(std::int32_t index)
+{
+    Node& node(nodes_[index]);
+    ++node.generation;
+    node.owner = nullptr;
+    node.next = free_;
+    free_ = index;
+    --size_;
+}
+
+void TimerWheel::cascade()
+{
+    // level k is spilled each time the k lower levels wrap around together
+    for (int level(1); level < LEVELS; ++level) {
+        if ((tick_ & ((std::uint64_t(1) << (SLOT_BITS * level)) - 1)) != 0) break;
+
+        std::int32_t& head(slots_[level * SLOTS + ((tick_ >> (SLOT_BITS * level)) & SLOT_MASK)]);
+        std::int32_t index(head);
+        head = NIL;
+        while (index != NIL) {
+            std::int32_t const next(nodes_[index].next);
+            insert(index);
+            index = next;
+        }
+    }
+}
@@ -0,0 +1,151 @@
+#pragma once
+#include <SFML/System.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+class OrganicEntity;
+
+/**
+ * @class TimerWheel
+ * @brief Hierarchical timer wheel delivering timed events to entities
+ *
+ * Behaviours that last a fixed time (feeding, mating, gestation...) are
+ * scheduled once, when they start, instead of being counted down by their
+ * entity on every tick. The environment advances the wheel with its clock
+ * and hands every due timer to its owner.
+ *
+ * Time is cut into ticks of one millisecond. The wheel has four levels of
+ * 64 slots: level k holds the timers due in less than 64^(k+1) ticks, each
+ * slot covering 64^k ticks, and its slots are spilled into the level below
+ * when their turn comes. Scheduling, cancelling and firing a timer are O(1);
+ * advancing costs one slot visit per elapsed tick, whatever the number of
+ * timers.
+ */
+class TimerWheel
+{
+public:
+    /**
+     * @brief Identifies a scheduled timer; NONE never refers to one
+     */
+    typedef std::uint64_t Handle;
+    static Handle const NONE = 0;
+
+    TimerWheel();
+
+    /**
+     * @brief Current time of the wheel
+     */
+    sf::Time getTime() const;
+
+    /**
+     * @brief Schedules an event for an entity
+     *
+     * @param delay time from now after which the event fires; a zero or
+     * negative delay fires at the next advance()
+     * @param owner entity receiving the event
+     * @param kind what the event is about, as understood by the owner
+     * @return handle of the timer, to cancel it
+     */
+    Handle schedule(sf::Time delay, OrganicEntity* owner, int kind);
+
+    /**
+     * @brief Cancels a timer and resets the handle to NONE
+     *
+     * Does nothing if the timer has already fired or been cancelled.
+     */
+    void cancel(Handle& handle);
+
+    /**
+     * @brief Tells whether a timer is still waiting to fire
+     */
+    bool isPending(Handle handle) const;
+
+    /**
+     * @brief Time a pending timer fires at, or zero if it isn't pending
+     */
+    sf::Time getDeadline(Handle handle) const;
+
+    /**
+     * @brief Number of pending timers
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Drops every timer
+     */
+    void clear();
+
+    /**
+     * @brief Moves time forward, firing the timers that fall due
+     *
+     * Timers fire in deadline order, each as fire(owner, kind). A fired
+     * timer is no longer pending when fire is called, and fire may
+     * schedule or cancel timers: while it runs, getTime() is the tick the
+     * timer fired at, from which new delays count.
+     *
+     * @param dt time to move forward by
+     * @param fire callable taking (OrganicEntity*, int)
+     */
+    template <typename F>
+    void advance(sf::Time dt, F fire)
+    {
+        sf::Time const end(time_ + dt);
+        std::uint64_t const target(toTick(end));
+        while (tick_ < target) {
+            ++tick_;
+            time_ = sf::microseconds(tick_ * MICROSECONDS_PER_TICK);
+            cascade();
+            std::int32_t& slot(slots_[tick_ & SLOT_MASK]);
+            while (slot != NIL) {
+                std::int32_t const index(slot);
+                OrganicEntity* owner(nodes_[index].owner);
+                int const kind(nodes_[index].kind);
+                unlink(index);
+                release(index);
+                fire(owner, kind);
+            }
+        }
+        time_ = end;
+    }
+
+private:
+    static int const LEVELS = 4;
+    static int const SLOT_BITS = 6;
+    static std::uint64_t const SLOTS = 1 << SLOT_BITS;
+    static std::uint64_t const SLOT_MASK = SLOTS - 1;
+    static std::int32_t const NIL = -1;
+    static sf::Int64 const MICROSECONDS_PER_TICK = 1000;
+
+    struct Node
+    {
+        std::uint64_t deadline;   ///< in ticks
+        OrganicEntity* owner;
+        int kind;
+        std::uint32_t generation; ///< bumped on every reuse, so old handles go stale
+        std::int32_t slot;        ///< index in slots_, NIL when free
+        std::int32_t previous;
+        std::int32_t next;
+    };
+
+    static std::uint64_t toTick(sf::Time time);
+
+    /**
+     * @brief Puts a node in the slot matching its deadline
+     */
+    void insert(std::int32_t index);
+    void unlink(std::int32_t index);
+    void release(std::int32_t index);
+
+    /**
+     * @brief Spills the higher level slots whose turn has come
+     */
+    void cascade();
+
+    sf::Time time_;
+    std::uint64_t tick_;
+    std::array<std::int32_t, LEVELS * SLOTS> slots_; ///< head node of each slot
+    std::vector<Node> nodes_;
+    std::int32_t free_;                              ///< head of the free nodes
+    std::size_t size_;
+};
@@ -3,6 +3,7 @@
 #include "../Application.hpp"
 #include "../Utility/Utility.hpp"
 #include "../src/Config.hpp"
+#include "../Utility/SmallVector.hpp"
 #include <cmath>
 #include <utility>
 #include <list>
@@ -16,19 +17,27 @@ Wave::Wave( const Vec2d& position, const double& wave_energy, const double& wave
     wave_speed_(wave_speed),
     wave_energy_current_(wave_energy),
     wave_intensity_(wave_energy),
-    wave_clock_(sf::Time::Zero)
+    wave_clock_(sf::Time::Zero),
+    occlusion_countdown_(0)
 {
     std::pair< double,double> pair1(-PI,PI);
     wave_list_pair_angles_.push_front(pair1);
 }
 
-void Wave::update(sf::Time dt)
+void Wave::update(Environment& env, sf::Time dt)
 {
     waveUpdateClock(dt);
     waveUpdateRadius();
     waveUpdateEnergy();
     waveUpdateIntensity();
-    waveUpdateListPairAngles();
+    // under load the obstacles are only tested every few updates: the
+    // shadows then start a little behind them
+    if (occlusion_countdown_ == 0) {
+        waveUpdateListPairAngles(env);
+        occlusion_countdown_ = env.getQuality().wave_occlusion_stride - 1;
+    } else {
+        --occlusion_countdown_;
+    }
 }
 void Wave::draw(sf::RenderTarget&  target) const
 {
@@ -66,10 +75,15 @@ void Wave::waveUpdateIntensity()  // I(t) = E0 * exp(-r(t)/µ) / (2 * PI * r(t))
 
 }
 
-void Wave::waveUpdateListPairAngles()
+void Wave::waveUpdateListPairAngles(Environment& env)
 {
 
-    std::list<CircularCollider*> liste(getAppEnv().getIsColliding(this));
+    // the obstacles hit are few: found once, without allocating, as every
+    // arc (the ones split off below included) is tested against all of them
+    SmallVector<CircularCollider*, 8> liste;
+    env.forEachColliding(*this, [&liste](CircularCollider* obstacle) {
+        liste.push_back(obstacle);
+    });
     for (auto& arc : wave_list_pair_angles_ ) {
         for (auto& obstacle : liste ) {
             if ( ((obstacle->getPosition() - this->getPosition()).angle() >= arc.first ) and ((obstacle->getPosition() - this->getPosition()).angle() <= arc.second  )) {
@@ -78,7 +92,6 @@ void Wave::waveUpdateListPairAngles()
             }
         }
     }
-    liste.clear();
 }
 double Wave::waveGetWaveEnergy() const
 {
@@ -2,11 +2,13 @@
 
 #include "../Utility/Vec2d.hpp"
 #include "../Obstacle/CircularCollider.hpp"
-#include "../Interface/Updatable.hpp"
 #include "../Interface/Drawable.hpp"
+#include <SFML/System.hpp>
 #include <utility>
 #include <list>
 
+class Environment;
+
 /**
  * @typedef pairdouble
  * @brief Shorthand for a pair of doubles representing angle ranges
@@ -32,7 +34,7 @@ typedef std::pair<double,double> pairdouble;
  * and other potential prey in their environment, simulating the way real scorpions
  * detect vibrations through substrate-borne mechanical waves.
  */
-class Wave : public CircularCollider, public Updatable
+class Wave : public CircularCollider
 {
 public:
     /**
@@ -50,9 +52,10 @@ public:
      * - waveUpdateIntensity: Updates intensity based on energy and radius
      * - waveUpdateListPairAngles: Handles collision with obstacles
      * 
+     * @param env Environment holding the obstacles the wave may hit
      * @param dt Time elapsed since last update
      */
-    virtual void update(sf::Time dt) override;
+    virtual void update(Environment& env, sf::Time dt);
 
     /**
      * @brief Renders the wave to the target window
@@ -150,8 +153,10 @@ protected:
      * When a wave encounters an obstacle, it splits into multiple arcs,
      * creating shadow zones behind obstacles where the wave doesn't propagate.
      * This method handles the creation and modification of these arc segments.
+     *
+     * @param env Environment holding the obstacles
      */
-    void waveUpdateListPairAngles();
+    void waveUpdateListPairAngles(Environment& env);
 
 private:
     /**
@@ -196,4 +201,10 @@ private:
      * where the wave is present. Obstacles create gaps in these arcs.
      */
     std::list<std::pair<double,double>> wave_list_pair_angles_;
+
+    /**
+     * @brief Updates left before the obstacles are tested again, see
+     *        SimulationQuality::wave_occlusion_stride
+     */
+    unsigned occlusion_countdown_;
 };
\ No newline at end of file
@@ -0,0 +1,219 @@
+#include "WorldTiles.hpp"
+#include "OrganicEntity.hpp"
+#include "../Random/RandomGenerator.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+thread_local WorldTiles::Tile* currentTile = nullptr;
+
+} // anonymous
+
+WorldTiles::WorldTiles()
+    : per_side_(0)
+    , job_(nullptr)
+    , generation_(0)
+    , busy_(0)
+    , stopping_(false)
+    , next_(0)
+{
+}
+
+WorldTiles::~WorldTiles()
+{
+    stopWorkers();
+}
+
+void WorldTiles::setup(unsigned perSide, unsigned workers)
+{
+    if (perSide < 2) perSide = 0;
+    if (workers == 0) workers = std::max(1u, std::thread::hardware_concurrency());
+    unsigned const threads(perSide == 0 ? 0 : std::min(workers, perSide * perSide) - 1);
+
+    if (perSide != per_side_) {
+        per_side_ = perSide;
+        tiles_.clear();
+        tiles_.resize(per_side_ * per_side_);
+    }
+    if (threads != workers_.size()) {
+        stopWorkers();
+        startWorkers(threads);
+    }
+}
+
+bool WorldTiles::active() const
+{
+    return per_side_ > 0;
+}
+
+void WorldTiles::assign(OrganicEntity* const* entities, double const* xs, double const* ys, std::size_t count,
+                        double worldSize, double halo)
+{
+    for (auto& tile : tiles_) {
+        tile.owned.clear();
+        tile.entities.clear();
+        tile.xs.clear();
+        tile.ys.clear();
+        tile.alerted.clear();
+    }
+    if (!active()) return;
+
+    double const tileSize(worldSize / per_side_);
+    auto add = [](Tile& tile, OrganicEntity* entity, double x, double y) {
+        tile.entities.push_back(entity);
+        tile.xs.push_back(x);
+        tile.ys.push_back(y);
+    };
+    auto ownerOf = [&](std::size_t i) {
+        int const column(wrap(static_cast<int>(std::floor(xs[i] / tileSize))));
+        int const row(wrap(static_cast<int>(std::floor(ys[i] / tileSize))));
+        return row * per_side_ + column;
+    };
+
+    // owned entities first, then the halos, each in storage order
+    for (std::size_t i(0); i < count; ++i) {
+        if (entities[i] == nullptr) continue;
+        Tile& tile(tiles_[ownerOf(i)]);
+        tile.owned.push_back(entities[i]);
+        add(tile, entities[i], xs[i], ys[i]);
+    }
+
+    int const side(per_side_);
+    for (std::size_t i(0); i < count; ++i) {
+        if (entities[i] == nullptr) continue;
+        int firstColumn(static_cast<int>(std::floor((xs[i] - halo) / tileSize)));
+        int lastColumn(static_cast<int>(std::floor((xs[i] + halo) / tileSize)));
+        int firstRow(static_cast<int>(std::floor((ys[i] - halo) / tileSize)));
+        int lastRow(static_cast<int>(std::floor((ys[i] + halo) / tileSize)));
+        // a halo wider than the world reaches every tile once
+        if (lastColumn - firstColumn >= side) { firstColumn = 0; lastColumn = side - 1; }
+        if (lastRow - firstRow >= side)       { firstRow = 0; lastRow = side - 1; }
+
+        std::size_t const owner(ownerOf(i));
+        for (int row(firstRow); row <= lastRow; ++row) {
+            for (int column(firstColumn); column <= lastColumn; ++column) {
+                std::size_t const index(wrap(row) * side + wrap(column));
+                if (index != owner) add(tiles_[index], entities[i], xs[i], ys[i]);
+            }
+        }
+    }
+}
+
+void WorldTiles::run(std::function<void(Tile&)> const& job)
+{
+    for (auto& tile : tiles_) {
+        tile.seed = getRandomGenerator()();
+    }
+    if (workers_.empty()) {
+        for (auto& tile : tiles_) {
+            runTile(tile, job);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = &job;
+        next_ = 0;
+        busy_ = workers_.size();
+        ++generation_;
+    }
+    start_.notify_all();
+    runTiles();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this]() { return busy_ == 0; });
+    job_ = nullptr;
+}
+
+void WorldTiles::deliverAlerts()
+{
+    for (auto& tile : tiles_) {
+        for (auto entity : tile.alerted) {
+            entity->alert();
+        }
+        tile.alerted.clear();
+    }
+}
+
+WorldTiles::Tile* WorldTiles::current()
+{
+    return currentTile;
+}
+
+std::vector<WorldTiles::Tile>& WorldTiles::getTiles()
+{
+    return tiles_;
+}
+
+std::vector<WorldTiles::Tile> const& WorldTiles::getTiles() const
+{
+    return tiles_;
+}
+
+void WorldTiles::startWorkers(unsigned count)
+{
+    stopping_ = false;
+    for (unsigned w(0); w < count; ++w) {
+        workers_.emplace_back(&WorldTiles::work, this);
+    }
+}
+
+void WorldTiles::stopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    start_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+}
+
+void WorldTiles::work()
+{
+    std::size_t seen(0);
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_.wait(lock, [this, seen]() { return stopping_ or generation_ != seen; });
+            if (stopping_) return;
+            seen = generation_;
+        }
+        runTiles();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--busy_ == 0) done_.notify_one();
+        }
+    }
+}
+
+void WorldTiles::runTiles()
+{
+    for (std::size_t i(next_++); i < tiles_.size(); i = next_++) {
+        runTile(tiles_[i], *job_);
+    }
+}
+
+void WorldTiles::runTile(Tile& tile, std::function<void(Tile&)> const& job)
+{
+    // the thread's own sequence is put back afterwards: the calling
+    // thread runs tiles too
+    std::default_random_engine& engine(getRandomGenerator());
+    std::default_random_engine const saved(engine);
+    engine.seed(tile.seed);
+    currentTile = &tile;
+    job(tile);
+    currentTile = nullptr;
+    engine = saved;
+}
+
+int WorldTiles::wrap(int index) const
+{
+    int const side(per_side_);
+    return ((index % side) + side) % side;
+}
@@ -0,0 +1,141 @@
+#pragma once
+#include "../Animal/SteeringBatch.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class OrganicEntity;
+
+/**
+ * @class WorldTiles
+ * @brief Splits the torus into square tiles updated in parallel
+ *
+ * Each tile owns the ticked entities standing in it at the start of the
+ * tick and mirrors, as its halo, those of the neighbouring tiles within
+ * the halo width. With a halo at least as wide as any view distance, an
+ * animal finds everything it can see among the entities of its own tile,
+ * so the tiles can be perceived and updated at the same time by a pool of
+ * worker threads. The halo ring wraps around the torus; the mirrored
+ * positions stay the world coordinates, as the sight itself does not wrap.
+ *
+ * On a tile, an entity only changes itself. Whatever would change the
+ * rest of the world is held by the tile until the run is over, then
+ * applied on the calling thread, tile after tile and in the order the
+ * tile's updates asked for it: alerts, eating, mating (and the births
+ * that follow), timers, bucket moves, bounces off the obstacles, new
+ * waves, and the moves of the steering batch. Each tile draws from its
+ * own random engine, seeded from the calling thread's one. A tick hence
+ * gives the same world whatever the number of workers and their timing,
+ * the ties between tiles (two scorpions eating one gerbil, two gerbils
+ * meeting the same mate) going to the first tile.
+ *
+ * Tiles are rebuilt from the positions of every tick: an entity that
+ * moved into another tile belongs to it from the next tick on.
+ */
+class WorldTiles
+{
+public:
+    /**
+     * @brief The entities of a tile, the scratch buffers of the thread
+     *        running it and what its updates left to apply
+     */
+    struct Tile
+    {
+        std::vector<OrganicEntity*> owned;    ///< entities standing in the tile, in storage order
+        std::vector<OrganicEntity*> entities; ///< owned, then the halo
+        std::vector<double> xs;               ///< positions of entities
+        std::vector<double> ys;
+        std::vector<std::uint32_t> selected;        ///< scratch buffer of the view cone over entities
+        std::vector<std::uint32_t> static_selected; ///< scratch buffer of the static entities' cone queries
+        std::vector<OrganicEntity*> alerted;  ///< entities alerted on the tile, see deliverAlerts()
+        std::vector<OrganicEntity*> rebucketed;       ///< entities whose update bucket may have changed
+        std::vector<std::function<void()>> deferred; ///< changes to the rest of the world, in order
+        SteeringBatch steering;               ///< moves of the tile's animals
+        std::uint32_t seed;                   ///< seed of the random engine for the current run()
+    };
+
+    WorldTiles();
+    ~WorldTiles();
+
+    WorldTiles(const WorldTiles&) = delete;
+    WorldTiles& operator=(const WorldTiles&) = delete;
+
+    /**
+     * @brief Sets the number of tiles along each side and of threads
+     *        running them, the calling one included
+     *
+     * @param perSide tiles per side; 0 or 1 disables the tiles
+     * @param workers threads; 0 for one per hardware thread
+     */
+    void setup(unsigned perSide, unsigned workers);
+
+    /**
+     * @brief Tells whether the world is split into tiles
+     */
+    bool active() const;
+
+    /**
+     * @brief Distributes the entities over the tiles
+     *
+     * @param entities ticked entities, null entries skipped
+     * @param xs their x coordinates
+     * @param ys their y coordinates
+     * @param count number of entities
+     * @param worldSize side of the (toric) world
+     * @param halo width of the halo
+     */
+    void assign(OrganicEntity* const* entities, double const* xs, double const* ys, std::size_t count,
+                double worldSize, double halo);
+
+    /**
+     * @brief Calls job on every tile, spread over the workers
+     *
+     * During a call, current() gives the tile on the calling thread, whose
+     * random engine (see getRandomGenerator()) is seeded for the tile from
+     * the engine of the thread calling run(). job must not throw.
+     */
+    void run(std::function<void(Tile&)> const& job);
+
+    /**
+     * @brief Alerts the entities alerted during the last run(), tile by tile
+     *
+     * Called between the perception and the updates, an alerted animal
+     * perceives again in its update of the same tick; after the updates,
+     * in the next tick.
+     */
+    void deliverAlerts();
+
+    /**
+     * @brief The tile being run by the calling thread, nullptr outside run()
+     */
+    static Tile* current();
+
+    std::vector<Tile>& getTiles();
+    std::vector<Tile> const& getTiles() const;
+
+private:
+    void startWorkers(unsigned count);
+    void stopWorkers();
+    void work();
+    void runTiles();
+    void runTile(Tile& tile, std::function<void(Tile&)> const& job);
+    int wrap(int index) const;
+
+    unsigned per_side_;
+    std::vector<Tile> tiles_;
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+    std::function<void(Tile&)> const* job_; ///< job of the current run()
+    std::size_t generation_;                ///< runs started so far
+    unsigned busy_;                         ///< workers not done with the current run()
+    bool stopping_;
+    std::atomic<std::size_t> next_;         ///< next tile to take
+};
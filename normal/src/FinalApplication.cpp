@@ -206,11 +206,13 @@ std::vector<std::string> FinalApplication::getHelperText() const
                     "A   : Remove a food generator",
 
                     "D   : Toggle debug mode",
+                    "P   : Dump tick timings (trace.json)",
                     "Tab : Switch macro/micro view",
                     "Z   : Zoom",
                     "->  : Move view to right",
                     "<-  : Move view to left",
-                    "Space : Pause"
+                    "Space : Pause",
+                    "T   : Turbo (fast forward)"
                };
     } else {
         return  {    "---------------------",
@@ -226,7 +228,8 @@ std::vector<std::string> FinalApplication::getHelperText() const
                      "Z   : Zoom",
                      "->  : Move view to right",
                      "<-  : Move view to left",
-                     "Space : Pause"
+                     "Space : Pause",
+                     "T  : Turbo (fast forward)"
                 };
     }
 }
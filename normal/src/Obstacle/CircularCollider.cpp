@@ -6,10 +6,10 @@
 
 CircularCollider::CircularCollider(Vec2d const& v, double const& r)
     :
-    v_(clamping(v)),
     r_(r/2)
 
 {
+    place(v);
     if( r < 0 ) {
         std::cerr << "negative radius" << std::endl ;
         throw 1 ;
@@ -35,12 +35,16 @@ CircularCollider::CircularCollider(const CircularCollider& c)
 
 CircularCollider&  CircularCollider::operator=(const CircularCollider& c)
 {
-    v_=clamping(c.v_);
+    place(c.v_);
     r_=c.r_;
     return *this;
 }
 Vec2d CircularCollider::directionTo(const Vec2d& to1) const
 {
+#ifdef INFOSV_FIXED_POINT
+    double const size(getAppConfig().simulation_world_size);
+    return p_.to(TorusPoint(to1, size), size);
+#else
     Vec2d to= clamping(to1);
     double min(10000);
     Vec2d vector;
@@ -57,13 +61,18 @@ Vec2d CircularCollider::directionTo(const Vec2d& to1) const
 
     }
     return vector;
+#endif
 }
 
 
 
 Vec2d CircularCollider::directionTo( const CircularCollider& c) const
 {
+#ifdef INFOSV_FIXED_POINT
+    return p_.to(c.p_, getAppConfig().simulation_world_size);
+#else
     return (directionTo(c.v_));
+#endif
 }
 
 
@@ -83,7 +92,13 @@ double CircularCollider::distanceTo(const CircularCollider& to) const
 
 void CircularCollider::move(const Vec2d& dx)
 {
+#ifdef INFOSV_FIXED_POINT
+    double const size(getAppConfig().simulation_world_size);
+    p_.move(dx, size);
+    v_ = p_.toVec2d(size);
+#else
     v_=clamping(v_+dx);
+#endif
 }
 
 CircularCollider& CircularCollider::operator+=(const Vec2d& dx)
@@ -99,7 +114,7 @@ bool	CircularCollider::isCircularColliderInside( const CircularCollider& other)
 {
 
 
-    if (( r_ >= other.r_ ) and ( distanceTo(other) <= (    r_ - other.r_  ) )) return true;
+    if (( r_ >= other.r_ ) and ( !directionTo(other).isLongerThan(r_ - other.r_) )) return true;
 
     return false;
 }
@@ -107,7 +122,7 @@ bool	CircularCollider::isCircularColliderInside( const CircularCollider& other)
 
 bool CircularCollider::isColliding( const CircularCollider& other) const
 {
-    if(distanceTo(other)<=(r_+other.r_)) return true;
+    if(!directionTo(other).isLongerThan(r_+other.r_)) return true;
     return false;
 
 }
@@ -115,7 +130,7 @@ bool CircularCollider::isColliding( const CircularCollider& other) const
 
 bool	CircularCollider::isPointInside(const Vec2d& v) const
 {
-    if (distanceTo(v)<= r_) return true;
+    if (!directionTo(v).isLongerThan(r_)) return true;
     return false;
 }
 
@@ -169,7 +184,18 @@ std::ostream& operator<<(std::ostream& s, CircularCollider const& c)
 
 void CircularCollider::setPosition(const Vec2d& v)
 {
+    place(v);
+}
+
+void CircularCollider::place(const Vec2d& v)
+{
+#ifdef INFOSV_FIXED_POINT
+    double const size(getAppConfig().simulation_world_size);
+    p_ = TorusPoint(v, size);
+    v_ = p_.toVec2d(size);
+#else
     v_= clamping(v);
+#endif
 }
 
 void  CircularCollider::draw(sf::RenderTarget&  targetWindow) const
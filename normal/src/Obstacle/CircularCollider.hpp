@@ -1,8 +1,17 @@
 #pragma once
 #include "../Utility/Vec2d.hpp"
+#include "../Utility/TorusPoint.hpp"
 #include  <SFML/Graphics.hpp>
 #include "../Interface/Drawable.hpp"
 
+/*!
+ * @brief A disc on the toric world
+ *
+ * When built with INFOSV_FIXED_POINT (scons fixedpoint=1), the position
+ * is kept as a TorusPoint: moves wrap around by integer overflow and
+ * directions are minimum images of integer differences. getPosition()
+ * then returns a Vec2d copy of it, refreshed on every move.
+ */
 class CircularCollider : public Drawable
 {
 public:
@@ -80,6 +89,12 @@ protected:
     void setRadius(const double&);
 
 private:
+    /// Sets the position, wrapped around the torus
+    void place(const Vec2d&);
+
+#ifdef INFOSV_FIXED_POINT
+    TorusPoint p_; ///< the position, v_ being its conversion
+#endif
     Vec2d v_;
     double r_;
 };
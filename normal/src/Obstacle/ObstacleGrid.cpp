@@ -0,0 +1,152 @@
+#include "ObstacleGrid.hpp"
+#include "../Utility/Constants.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace // anonymous
+{
+
+int const MAX_CELLS = 64; ///< per axis
+
+int wrap(int cell, int cells)
+{
+    return ((cell % cells) + cells) % cells;
+}
+
+} // anonymous
+
+ObstacleGrid::ObstacleGrid()
+    : dirty_(true)
+    , cells_(1)
+    , cell_size_(1)
+    , stamp_(0)
+{
+}
+
+void ObstacleGrid::markDirty()
+{
+    dirty_ = true;
+}
+
+bool ObstacleGrid::isDirty() const
+{
+    return dirty_;
+}
+
+void ObstacleGrid::build(std::list<CircularCollider*> const& obstacles, double worldSize)
+{
+    obstacles_.clear();
+    double maxRadius(0);
+    for (auto obstacle : obstacles) {
+        if (obstacle != nullptr) {
+            obstacles_.push_back(obstacle);
+            maxRadius = std::max(maxRadius, obstacle->getRadius());
+        }
+    }
+
+    // Cells about as wide as the largest obstacle: each obstacle then
+    // spans at most a few cells
+    cells_ = maxRadius > 0 ? static_cast<int>(worldSize / (2 * maxRadius)) : 1;
+    cells_ = std::max(1, std::min(MAX_CELLS, cells_));
+    cell_size_ = worldSize / cells_;
+
+    // Two passes: count the entries of each cell, then fill them
+    std::vector<std::vector<int>> columns(obstacles_.size()), rows(obstacles_.size());
+    cell_start_.assign(cells_ * cells_ + 1, 0);
+    for (std::size_t i(0); i < obstacles_.size(); ++i) {
+        Vec2d const& p(obstacles_[i]->getPosition());
+        double const r(obstacles_[i]->getRadius());
+        int first, last;
+        for (int pass(0); pass < 2; ++pass) {
+            auto& axis(pass == 0 ? columns[i] : rows[i]);
+            double const centre(pass == 0 ? p.x : p.y);
+            if (cellRange(centre - r, centre + r, first, last)) {
+                for (int c(first); c <= last; ++c) axis.push_back(wrap(c, cells_));
+            } else {
+                for (int c(0); c < cells_; ++c) axis.push_back(c);
+            }
+        }
+        for (int column : columns[i]) {
+            for (int row : rows[i]) {
+                ++cell_start_[row * cells_ + column + 1];
+            }
+        }
+    }
+    for (std::size_t c(1); c < cell_start_.size(); ++c) {
+        cell_start_[c] += cell_start_[c - 1];
+    }
+    cell_items_.resize(cell_start_.back());
+    std::vector<std::uint32_t> fill(cell_start_.begin(), cell_start_.end() - 1);
+    for (std::size_t i(0); i < obstacles_.size(); ++i) {
+        for (int column : columns[i]) {
+            for (int row : rows[i]) {
+                cell_items_[fill[row * cells_ + column]++] = i;
+            }
+        }
+    }
+
+    stamps_.assign(obstacles_.size(), 0);
+    stamp_ = 0;
+    dirty_ = false;
+}
+
+bool ObstacleGrid::cellRange(double low, double high, int& first, int& last) const
+{
+    // checked in floating point first: a grown wave may be far wider than the world
+    if (high - low >= (cells_ - 1) * cell_size_) return false;
+    first = static_cast<int>(std::floor(low / cell_size_));
+    last = static_cast<int>(std::floor(high / cell_size_));
+    return last - first + 1 < cells_;
+}
+
+bool ObstacleGrid::overlaps(std::uint32_t index, Vec2d const& position, double radius) const
+{
+    // exactly CircularCollider::isColliding
+    CircularCollider const* obstacle(obstacles_[index]);
+    return !obstacle->directionTo(position).isLongerThan(obstacle->getRadius() + radius);
+}
+
+void ObstacleGrid::gather(Vec2d const& position, double radius) const
+{
+    found_.clear();
+
+    // the margin keeps touching circles in a common cell despite rounding
+    double const reach(radius + EPSILON);
+    int firstColumn, lastColumn, firstRow, lastRow;
+    bool const narrowX(cellRange(position.x - reach, position.x + reach, firstColumn, lastColumn));
+    bool const narrowY(cellRange(position.y - reach, position.y + reach, firstRow, lastRow));
+
+    if (!narrowX and !narrowY) {
+        // the circle covers the whole world (e.g. a grown wave)
+        for (std::uint32_t i(0); i < obstacles_.size(); ++i) {
+            if (overlaps(i, position, radius)) found_.push_back(i);
+        }
+        return;
+    }
+    if (!narrowX) {
+        firstColumn = 0;
+        lastColumn = cells_ - 1;
+    }
+    if (!narrowY) {
+        firstRow = 0;
+        lastRow = cells_ - 1;
+    }
+
+    if (++stamp_ == 0) { // wrapped around: forget every old stamp
+        std::fill(stamps_.begin(), stamps_.end(), 0);
+        stamp_ = 1;
+    }
+    for (int row(firstRow); row <= lastRow; ++row) {
+        for (int column(firstColumn); column <= lastColumn; ++column) {
+            int const cell(wrap(row, cells_) * cells_ + wrap(column, cells_));
+            for (std::uint32_t k(cell_start_[cell]); k < cell_start_[cell + 1]; ++k) {
+                std::uint32_t const i(cell_items_[k]);
+                if (stamps_[i] != stamp_) {
+                    stamps_[i] = stamp_;
+                    if (overlaps(i, position, radius)) found_.push_back(i);
+                }
+            }
+        }
+    }
+    std::sort(found_.begin(), found_.end());
+}
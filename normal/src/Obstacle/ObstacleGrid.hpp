@@ -0,0 +1,92 @@
+#pragma once
+#include "CircularCollider.hpp"
+#include <cstdint>
+#include <list>
+#include <vector>
+
+/**
+ * @class ObstacleGrid
+ * @brief Broad-phase index answering "which obstacles does this circle overlap?"
+ *
+ * Obstacles (rocks) never move, so the grid is built once from the
+ * environment's obstacle list and rebuilt only after it was marked dirty
+ * (an obstacle added or the environment cleaned). The world is cut into
+ * square cells, wrapped around like the torus; each obstacle is listed in
+ * every cell its bounding box touches. A query only looks at the cells
+ * touched by its own bounding box, then applies the exact torus test of
+ * CircularCollider::isColliding to the candidates.
+ *
+ * Queries allocate nothing once the scratch buffers have grown, and report
+ * the colliding obstacles in the order they were added to the environment.
+ */
+class ObstacleGrid
+{
+public:
+    ObstacleGrid();
+
+    /**
+     * @brief Forces a rebuild before the next query
+     */
+    void markDirty();
+
+    /**
+     * @brief Tells whether build() must be called before querying
+     */
+    bool isDirty() const;
+
+    /**
+     * @brief Indexes the given obstacles
+     *
+     * @param obstacles obstacles to index, in the environment's order
+     * @param worldSize side of the (square, toroidal) world
+     */
+    void build(std::list<CircularCollider*> const& obstacles, double worldSize);
+
+    /**
+     * @brief Calls f on every obstacle overlapping a circle
+     *
+     * An obstacle overlaps when its torus distance to position is at most
+     * its radius plus the given radius.
+     *
+     * @param position centre of the circle
+     * @param radius radius of the circle
+     * @param f callable taking a CircularCollider*
+     */
+    template <typename F>
+    void forEachColliding(Vec2d const& position, double radius, F f) const
+    {
+        gather(position, radius);
+        for (auto index : found_) {
+            f(obstacles_[index]);
+        }
+    }
+
+private:
+    /**
+     * @brief Fills found_ with the indices of the overlapping obstacles, sorted
+     */
+    void gather(Vec2d const& position, double radius) const;
+
+    /**
+     * @brief Cell range covered by [low, high] along one axis, in cell units
+     *
+     * @return false if the range wraps over the whole axis
+     */
+    bool cellRange(double low, double high, int& first, int& last) const;
+
+    /**
+     * @brief Applies the exact overlap test to one obstacle
+     */
+    bool overlaps(std::uint32_t index, Vec2d const& position, double radius) const;
+
+    bool dirty_;
+    int cells_;                           ///< number of cells along each axis
+    double cell_size_;
+    std::vector<CircularCollider*> obstacles_;
+    std::vector<std::uint32_t> cell_start_; ///< cell c lists cell_items_[cell_start_[c], cell_start_[c+1])
+    std::vector<std::uint32_t> cell_items_; ///< obstacle indices, grouped by cell
+
+    mutable std::vector<std::uint32_t> found_;  ///< result of the last query
+    mutable std::vector<std::uint32_t> stamps_; ///< per obstacle: last query that met it
+    mutable std::uint32_t stamp_;
+};
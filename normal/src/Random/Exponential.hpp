@@ -9,6 +9,7 @@
 
 #include <cmath>
 #include <random>
+#include "RandomGenerator.hpp"
 
 /*!
  * @brief Randomly generate a number on a exponential distribution
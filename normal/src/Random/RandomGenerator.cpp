@@ -0,0 +1,38 @@
+/*
+ * infosv
+ * 2019
+ */
+
+#include "RandomGenerator.hpp"
+
+namespace // anonymous
+{
+
+struct ThreadEngine
+{
+    ThreadEngine()
+    {
+        std::random_device rd;
+        engine.seed(rd());
+    }
+
+    std::default_random_engine engine;
+};
+
+ThreadEngine& threadEngine()
+{
+    static thread_local ThreadEngine local;
+    return local;
+}
+
+} // anonymous
+
+std::default_random_engine& getRandomGenerator()
+{
+    return threadEngine().engine;
+}
+
+void seedRandomGenerator(unsigned int seed)
+{
+    threadEngine().engine.seed(seed);
+}
@@ -0,0 +1,32 @@
+/*
+ * infosv
+ * 2019
+ */
+
+#ifndef INFOSV_RANDOM_GENERATOR_HPP
+#define INFOSV_RANDOM_GENERATOR_HPP
+
+#include <random>
+
+/*!
+ * @brief Get the random engine of the calling thread
+ *
+ * Every thread owns its engine, so worlds simulated on different
+ * threads never share (nor race on) a random sequence. The engine is
+ * seeded from std::random_device on first use unless seedRandomGenerator()
+ * was called before.
+ *
+ * @return the thread's random engine
+ */
+std::default_random_engine& getRandomGenerator();
+
+/*!
+ * @brief Reseed the random engine of the calling thread
+ *
+ * Used to make a simulated world reproducible.
+ *
+ * @param seed new seed
+ */
+void seedRandomGenerator(unsigned int seed);
+
+#endif // INFOSV_RANDOM_GENERATOR_HPP
@@ -8,6 +8,7 @@
 #define INFOSV_RANDOM_UNIFORM_HPP
 
 #include "../Utility/Vec2d.hpp"
+#include "RandomGenerator.hpp"
 
 #include <type_traits>
 #include <random>
@@ -22,15 +23,6 @@
 template <typename T>
 T uniform(T min, T max)
 {
-    static std::default_random_engine algo;
-
-    static bool initialise = true;
-    if (initialise) {
-        initialise = false;
-        std::random_device rd;
-        algo.seed(rd());
-    }
-
     typedef typename std::is_integral<T> condition;
     typedef typename std::uniform_int_distribution<T> integer_dist;
     typedef typename std::uniform_real_distribution<T> real_dist;
@@ -41,7 +33,7 @@ T uniform(T min, T max)
 
     distribution_type dist(min, max);
 
-    return dist(algo);
+    return dist(getRandomGenerator());
 }
 
 template <>
@@ -9,18 +9,19 @@
 #include "../Application.hpp"
 #include "../Utility/Utility.hpp"
 #include <unordered_map>
-Stats::Stats() : stats_active_index_(-1),stats_clock_(sf::Time::Zero),stats_clock_refresh_(sf::Time::Zero),stats_time_refresh_rate_(sf::seconds(getAppConfig().stats_refresh_rate )) {}
+Stats::Stats() : stats_active_index_(-1),stats_clock_(sf::Time::Zero)
+{
+    stats_clock_refresh_.setPeriod(sf::seconds(getAppConfig().stats_refresh_rate));
+}
 
 void Stats::update(sf::Time dt)
 {
     stats_clock_ += dt;
-    stats_clock_refresh_+= dt;
 
-    if (stats_clock_refresh_ >= stats_time_refresh_rate_) {
+    if (stats_clock_refresh_.advance(dt)) {
         stats_map_index_graph_[stats_active_index_]->updateData(
-            stats_clock_refresh_
+            stats_clock_refresh_.consume()
             , getAppEnv().fetchData(stats_map_index_label_[stats_active_index_]));
-        stats_clock_refresh_= sf::Time::Zero;
     }
 }
 
@@ -5,6 +5,7 @@
 #include <memory>
 #include "../Interface/Updatable.hpp"
 #include "../Utility/Vec2d.hpp"
+#include "../Environment/SubsystemClock.hpp"
 #include <string>
 #include <map>
 class Stats: public Drawable,
@@ -38,8 +39,7 @@ public:
 private:
     int stats_active_index_;
     sf::Time stats_clock_;
-    sf::Time stats_clock_refresh_;
-    sf::Time stats_time_refresh_rate_;
+    SubsystemClock stats_clock_refresh_; ///< samples the active graph every stats_refresh_rate
 
     std::unordered_map<int,std::unique_ptr<Graph>> stats_map_index_graph_;
 
@@ -0,0 +1,264 @@
+#include "Sweep.hpp"
+#include "../Application.hpp"
+#include "../Animal/Gerbil.hpp"
+#include "../Animal/Scorpion.hpp"
+#include "../Environment/FoodGenerator.hpp"
+#include "../JSON/JSONSerialiser.hpp"
+#include "../Obstacle/Rock.hpp"
+#include "../Random/RandomGenerator.hpp"
+#include "../Random/Uniform.hpp"
+#include "../Utility/Utility.hpp"
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace // anonymous
+{
+
+std::list<std::string> propertyPath(std::string const& path)
+{
+    auto tokens(split(path, '/'));
+    return std::list<std::string>(tokens.begin(), tokens.end());
+}
+
+Vec2d randomPosition(double worldSize)
+{
+    return uniform(Vec2d(0.0, 0.0), Vec2d(worldSize, worldSize));
+}
+
+void updateExtinction(double& extinction, unsigned int count, double time)
+{
+    if (count == 0 && extinction < 0.0) {
+        extinction = time;
+    }
+}
+
+} // anonymous
+
+Sweep::Sweep(std::string const& specPath, std::string const& resDirectory)
+    : base_config_(j::object())
+    , workers_(0)
+{
+    j::Value spec(j::readFromFile(specPath));
+
+    base_config_ = j::readFromFile(resDirectory + spec["config"].toString());
+    workers_ = spec["workers"].toInt();
+    if (workers_ == 0) {
+        workers_ = std::max(1u, std::thread::hardware_concurrency());
+    }
+    duration_ = spec["duration"].toDouble();
+    sample_period_ = spec["sample period"].toDouble();
+    gerbils_ = spec["population"]["gerbils"].toInt();
+    scorpions_ = spec["population"]["scorpions"].toInt();
+    food_generators_ = spec["population"]["food generators"].toInt();
+    rocks_ = spec["population"]["rocks"].toInt();
+    output_ = spec["output"].toString();
+
+    // Cartesian product of the grid values, the last path varying fastest
+    j::Value const& grid(spec["grid"]);
+    std::vector<std::vector<SweepParameter>> combinations(1);
+    for (auto const& path : grid.keys()) {
+        j::getProperty(base_config_, propertyPath(path)); // fail early on typos
+        grid_paths_.push_back(path);
+
+        std::vector<std::vector<SweepParameter>> extended;
+        for (auto const& combination : combinations) {
+            for (std::size_t i(0); i < grid[path].size(); ++i) {
+                extended.push_back(combination);
+                extended.back().push_back({ path, grid[path][i].toDouble() });
+            }
+        }
+        combinations.swap(extended);
+    }
+
+    unsigned int const seeds(spec["seeds"].toInt());
+    unsigned int const firstSeed(spec["first seed"].toInt());
+    for (auto const& combination : combinations) {
+        for (unsigned int s(0); s < seeds; ++s) {
+            runs_.push_back({ static_cast<unsigned int>(runs_.size()), firstSeed + s, combination });
+        }
+    }
+}
+
+std::vector<SweepRun> const& Sweep::getRuns() const
+{
+    return runs_;
+}
+
+unsigned int Sweep::getWorkers() const
+{
+    return workers_;
+}
+
+std::string const& Sweep::getOutput() const
+{
+    return output_;
+}
+
+std::vector<SweepResult> Sweep::runAll() const
+{
+    std::vector<SweepResult> results(runs_.size());
+    std::atomic<std::size_t> next(0);
+    std::mutex logMutex;
+
+    // Each worker pulls the next run until none is left; every result
+    // has its own slot so no locking is needed to store it.
+    auto worker = [&]() {
+        for (std::size_t i(next++); i < runs_.size(); i = next++) {
+            results[i] = runOne(runs_[i]);
+
+            std::lock_guard<std::mutex> lock(logMutex);
+            std::cerr << "run " << i + 1 << "/" << runs_.size()
+                      << " (seed " << runs_[i].seed << ") "
+                      << (results[i].error.empty() ? "done" : "failed: " + results[i].error)
+                      << "\n";
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned int w(0); w < std::min<std::size_t>(workers_, runs_.size()); ++w) {
+        pool.emplace_back(worker);
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    return results;
+}
+
+SweepResult Sweep::runOne(SweepRun const& run) const
+{
+    SweepResult result;
+    result.run = run;
+
+    auto const start(std::chrono::steady_clock::now());
+    try {
+        seedRandomGenerator(run.seed);
+
+        j::Value json(base_config_);
+        for (auto const& parameter : run.parameters) {
+            j::getProperty(json, propertyPath(parameter.path)) = j::number(parameter.value);
+        }
+
+        Config config(json);
+        WorldBinding configBinding(config); // entities read the config when built
+        Environment env;
+        WorldBinding worldBinding(config, env);
+
+        double const size(config.simulation_world_size);
+        for (unsigned int i(0); i < food_generators_; ++i) {
+            env.addGenerator(new FoodGenerator());
+        }
+        for (unsigned int i(0); i < rocks_; ++i) {
+            Rock* rock = new Rock(randomPosition(size));
+            env.addObstacle(rock);
+            env.addRock(rock);
+        }
+        for (unsigned int i(0); i < gerbils_; ++i) {
+            env.addEntity(new Gerbil(randomPosition(size)));
+        }
+        for (unsigned int i(0); i < scorpions_; ++i) {
+            env.addEntity(new Scorpion(randomPosition(size)));
+        }
+
+        sf::Time const dt(config.simulation_time_max_dt);
+        sf::Time const duration(sf::seconds(duration_));
+        sf::Time const samplePeriod(sf::seconds(sample_period_));
+        sf::Time time(sf::Time::Zero);
+        sf::Time nextSample(sf::Time::Zero);
+        unsigned int samples(0);
+        Environment::Footprint footprints;
+
+        while (true) {
+            if (time >= nextSample || time >= duration) {
+                unsigned int const gerbils(env.countGerbils());
+                unsigned int const scorpions(env.countScorpions());
+                unsigned int const food(env.countFood());
+
+                ++samples;
+                result.mean_gerbils += gerbils;
+                result.mean_scorpions += scorpions;
+                result.mean_food += food;
+                result.max_gerbils = std::max(result.max_gerbils, gerbils);
+                result.max_scorpions = std::max(result.max_scorpions, scorpions);
+                result.max_food = std::max(result.max_food, food);
+                if (gerbils_ > 0) {
+                    updateExtinction(result.gerbils_extinction, gerbils, time.asSeconds());
+                }
+                if (scorpions_ > 0) {
+                    updateExtinction(result.scorpions_extinction, scorpions, time.asSeconds());
+                }
+                result.final_gerbils = gerbils;
+                result.final_scorpions = scorpions;
+                result.final_food = food;
+
+                Environment::Footprint const footprint(env.getTickedFootprint());
+                footprints.entities += footprint.entities;
+                footprints.bytes += footprint.bytes;
+                footprints.heap_bytes += footprint.heap_bytes;
+
+                nextSample += samplePeriod;
+            }
+
+            if (time >= duration) {
+                break;
+            }
+
+            auto const updateStart(std::chrono::steady_clock::now());
+            env.update(dt);
+            result.update_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - updateStart).count();
+            time += dt;
+        }
+
+        result.simulated_time = time.asSeconds();
+        result.mean_gerbils /= samples;
+        result.mean_scorpions /= samples;
+        result.mean_food /= samples;
+        if (footprints.entities > 0) {
+            result.bytes_per_animal = static_cast<double>(footprints.bytes) / footprints.entities;
+            result.heap_bytes_per_animal = static_cast<double>(footprints.heap_bytes) / footprints.entities;
+        }
+    } catch (std::exception const& e) {
+        result.error = e.what();
+    }
+    result.wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return result;
+}
+
+void Sweep::writeSummary(std::vector<SweepResult> const& results) const
+{
+    std::ofstream out(output_);
+    if (!out) {
+        throw std::runtime_error("Couldn't write sweep summary to " + output_);
+    }
+
+    out << "run,seed";
+    for (auto const& path : grid_paths_) {
+        out << ",\"" << path << "\"";
+    }
+    out << ",simulated time,wall time,update time"
+        << ",final gerbils,final scorpions,final food"
+        << ",mean gerbils,mean scorpions,mean food"
+        << ",max gerbils,max scorpions,max food"
+        << ",gerbils extinction,scorpions extinction"
+        << ",bytes per animal,heap bytes per animal,error\n";
+
+    for (auto const& r : results) {
+        out << r.run.index << "," << r.run.seed;
+        for (auto const& parameter : r.run.parameters) {
+            out << "," << parameter.value;
+        }
+        out << "," << r.simulated_time << "," << r.wall_time << "," << r.update_time
+            << "," << r.final_gerbils << "," << r.final_scorpions << "," << r.final_food
+            << "," << r.mean_gerbils << "," << r.mean_scorpions << "," << r.mean_food
+            << "," << r.max_gerbils << "," << r.max_scorpions << "," << r.max_food
+            << "," << r.gerbils_extinction << "," << r.scorpions_extinction
+            << "," << r.bytes_per_animal << "," << r.heap_bytes_per_animal
+            << ",\"" << r.error << "\"\n";
+    }
+}
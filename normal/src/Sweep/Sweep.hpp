@@ -0,0 +1,126 @@
+#pragma once
+#include "../JSON/JSON.hpp"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Value given to one swept parameter
+ */
+struct SweepParameter
+{
+    std::string path; ///< '/'-separated path of the value in the config, e.g. "simulation/food generator/delta"
+    double value;     ///< Value overriding the one of the base config
+};
+
+/**
+ * @brief Description of one independent world of a sweep
+ */
+struct SweepRun
+{
+    unsigned int index;                     ///< Row of the run in the summary
+    unsigned int seed;                      ///< Seed of the world's random engine
+    std::vector<SweepParameter> parameters; ///< Overrides applied to the base config
+};
+
+/**
+ * @brief What is measured on one world of a sweep
+ *
+ * Extinction times are negative when the species never went extinct
+ * (or was absent from the start).
+ */
+struct SweepResult
+{
+    SweepRun run;                   ///< Run these results belong to
+    double simulated_time = 0.0;    ///< Simulated seconds
+    double wall_time = 0.0;         ///< Real seconds spent simulating
+    double update_time = 0.0;       ///< Real seconds spent in Environment::update
+    unsigned int final_gerbils = 0;
+    unsigned int final_scorpions = 0;
+    unsigned int final_food = 0;
+    unsigned int max_gerbils = 0;
+    unsigned int max_scorpions = 0;
+    unsigned int max_food = 0;
+    double mean_gerbils = 0.0;
+    double mean_scorpions = 0.0;
+    double mean_food = 0.0;
+    double gerbils_extinction = -1.0;
+    double scorpions_extinction = -1.0;
+    double bytes_per_animal = 0.0;      ///< Mean over the samples of the memory block of an animal
+    double heap_bytes_per_animal = 0.0; ///< Mean over the samples of what an animal allocates itself
+    std::string error;              ///< Empty unless the run threw
+};
+
+/**
+ * @class Sweep
+ * @brief Runs an ensemble of independent worlds on a pool of threads
+ *
+ * A sweep is described by a json file (see res/sweep.json): a base config,
+ * a number of seeds, an initial population and a grid of config values.
+ * Every combination of grid values is simulated once per seed, each world
+ * with its own Config, Environment and random engine bound to the worker
+ * thread simulating it (see WorldBinding), so worlds never share state.
+ */
+class Sweep
+{
+public:
+    /**
+     * @brief Load a sweep description
+     *
+     * @param specPath path of the sweep json file
+     * @param resDirectory directory in which the base config is looked up
+     *
+     * @throw j::NoSuchElement when a grid path is not in the base config
+     */
+    Sweep(std::string const& specPath, std::string const& resDirectory);
+
+    /**
+     * @brief Gets the runs making the sweep, in summary order
+     */
+    std::vector<SweepRun> const& getRuns() const;
+
+    /**
+     * @brief Gets the number of worker threads used by runAll()
+     */
+    unsigned int getWorkers() const;
+
+    /**
+     * @brief Gets the path of the summary file
+     */
+    std::string const& getOutput() const;
+
+    /**
+     * @brief Simulates every run on the worker pool
+     *
+     * @return results, in the same order as getRuns()
+     */
+    std::vector<SweepResult> runAll() const;
+
+    /**
+     * @brief Simulates a single world on the calling thread
+     *
+     * @param run world to simulate
+     * @return its measures
+     */
+    SweepResult runOne(SweepRun const& run) const;
+
+    /**
+     * @brief Writes the results as a single csv summary file
+     *
+     * @param results results of runAll()
+     * @throw std::runtime_error if the file can't be written
+     */
+    void writeSummary(std::vector<SweepResult> const& results) const;
+
+private:
+    j::Value base_config_;         ///< Config every run starts from
+    std::vector<std::string> grid_paths_; ///< Swept parameters, in summary column order
+    std::vector<SweepRun> runs_;   ///< Every (grid combination, seed) pair
+    unsigned int workers_;         ///< Size of the thread pool
+    double duration_;              ///< Simulated seconds per run
+    double sample_period_;         ///< Simulated seconds between two population samples
+    unsigned int gerbils_;         ///< Initial population
+    unsigned int scorpions_;
+    unsigned int food_generators_;
+    unsigned int rocks_;
+    std::string output_;           ///< Summary file
+};
@@ -0,0 +1,47 @@
+/*
+ * prjsv 2019
+ * Headless ensemble runner: simulates the worlds described by a sweep
+ * file (res/sweep.json by default) and writes a csv summary.
+ */
+
+#include "Config.hpp"
+#include <Sweep/Sweep.hpp>
+
+#include <iostream>
+#include <string>
+
+namespace // anonymous
+{
+
+std::string applicationDirectory(char const* argv0)
+{
+    auto dir = std::string(argv0);
+
+    auto lastSlashPos = dir.rfind('/');
+    if (lastSlashPos == std::string::npos) {
+        return "./";
+    }
+    return dir.substr(0, lastSlashPos + 1);
+}
+
+} // anonymous
+
+int main(int argc, char const** argv)
+try {
+    auto const res(applicationDirectory(argv[0]) + RES_LOCATION);
+    auto const spec(res + (argc >= 2 ? argv[1] : "sweep.json"));
+
+    std::cerr << "Using " << spec << " for the sweep.\n";
+
+    Sweep sweep(spec, res);
+    std::cerr << sweep.getRuns().size() << " runs on "
+              << sweep.getWorkers() << " workers\n";
+
+    sweep.writeSummary(sweep.runAll());
+    std::cerr << "Summary written to " << sweep.getOutput() << "\n";
+
+    return 0;
+} catch (std::exception const& e) {
+    std::cerr << "FATAL ERROR: " << e.what() << "\n";
+    return 1;
+}
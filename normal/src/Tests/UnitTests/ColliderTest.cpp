@@ -21,6 +21,34 @@ public:
     }
 };
 
+// With scons fixedpoint=1 the positions are rounded to the nearest step of
+// worldSize / 2^32 on the torus: two positions or bodies placed exactly may
+// then be a step apart. Both helpers are exact in the default build.
+namespace
+{
+
+bool samePosition(Vec2d const& a, Vec2d const& b)
+{
+#ifdef INFOSV_FIXED_POINT
+    double const step(getAppConfig().simulation_world_size / 4294967296.0);
+    return !(a - b).isLongerThan(2 * step);
+#else
+    return a == b;
+#endif
+}
+
+bool touching(CircularCollider const& a, CircularCollider const& b)
+{
+#ifdef INFOSV_FIXED_POINT
+    double const step(getAppConfig().simulation_world_size / 4294967296.0);
+    return !a.directionTo(b).isLongerThan(a.getRadius() + b.getRadius() + 2 * step);
+#else
+    return a.isColliding(b);
+#endif
+}
+
+} // namespace
+
 SCENARIO("Collision/IsCircularColliderInside with CircularCollider", "[Body]")
 {
     GIVEN("Two identical bodies") {
@@ -122,9 +150,9 @@ SCENARIO("Collision/IsCircularColliderInside with CircularCollider", "[Body]")
 
         THEN("it moves correctly") {
             b.move({ 1, 0 });
-            CHECK(Vec2d(2, 2) == b.getPosition());
+            CHECK(samePosition(Vec2d(2, 2), b.getPosition()));
             b += { -2, -2 };
-            CHECK(Vec2d(0, 0) == b.getPosition());
+            CHECK(samePosition(Vec2d(0, 0), b.getPosition()));
         }
 
         THEN("it can be copied") {
@@ -171,11 +199,11 @@ SCENARIO("Collision/IsCircularColliderInside with CircularCollider using toric p
         auto b5 = Body({ -4,  2 }, 2);
 
         THEN("some collide, some don't") {
-            CHECK(b1.isColliding(b2));
-            CHECK(b2.isColliding(b1));
+            CHECK(touching(b1, b2));
+            CHECK(touching(b2, b1));
 
-            CHECK(b1.isColliding(b3));
-            CHECK(b3.isColliding(b1));
+            CHECK(touching(b1, b3));
+            CHECK(touching(b3, b1));
 
             CHECK(b1.isColliding(b4));
             CHECK(b4.isColliding(b1));
@@ -186,14 +214,14 @@ SCENARIO("Collision/IsCircularColliderInside with CircularCollider using toric p
             CHECK(b2.isColliding(b3));
             CHECK(b3.isColliding(b2));
 
-            CHECK(b2.isColliding(b4));
-            CHECK(b4.isColliding(b2));
+            CHECK(touching(b2, b4));
+            CHECK(touching(b4, b2));
 
             CHECK(!b2.isColliding(b5));
             CHECK(!b5.isColliding(b2));
 
-            CHECK(b3.isColliding(b4));
-            CHECK(b4.isColliding(b3));
+            CHECK(touching(b3, b4));
+            CHECK(touching(b4, b3));
 
             CHECK(b3.isColliding(b5));
             CHECK(b5.isColliding(b3));
@@ -289,12 +317,12 @@ SCENARIO("Collision/IsCircularColliderInside with CircularCollider using toric p
         }
 
         AND_THEN("directionTo works") {
-            CHECK(b.directionTo(u) == Vec2d( 1, 1 ));
-            CHECK(b.directionTo(v) == Vec2d( 1, 0 ));
-            CHECK(b.directionTo(w) == Vec2d( 0, 1 ));
-            CHECK(b.directionTo(x) == Vec2d( -2, 0 ));
-            CHECK(b.directionTo(y) == Vec2d( 0, -2 ));
-            CHECK(b.directionTo(z) == Vec2d( -2, -2 ));
+            CHECK(samePosition(b.directionTo(u), Vec2d( 1, 1 )));
+            CHECK(samePosition(b.directionTo(v), Vec2d( 1, 0 )));
+            CHECK(samePosition(b.directionTo(w), Vec2d( 0, 1 )));
+            CHECK(samePosition(b.directionTo(x), Vec2d( -2, 0 )));
+            CHECK(samePosition(b.directionTo(y), Vec2d( 0, -2 )));
+            CHECK(samePosition(b.directionTo(z), Vec2d( -2, -2 )));
         }
     }
 }
@@ -0,0 +1,120 @@
+#include <Utility/FrameGovernor.hpp>
+
+#include <catch.hpp>
+
+namespace
+{
+
+sf::Time const BUDGET(sf::milliseconds(10));
+
+void record(FrameGovernor& governor, sf::Time cost, unsigned frames)
+{
+    for (unsigned frame(0); frame < frames; ++frame) {
+        governor.record(cost);
+    }
+}
+
+} // anonymous
+
+SCENARIO("The governor degrades the quality in order while frames are over budget", "[FrameGovernor]")
+{
+    GIVEN("A governor with a budget of 10 ms") {
+        FrameGovernor governor;
+        governor.setBudget(BUDGET);
+
+        THEN("the quality is full to begin with") {
+            CHECK(governor.getLevel() == FrameGovernor::FULL_QUALITY);
+            CHECK(governor.getQuality().perception_stretch == 1);
+            CHECK(governor.getQuality().wave_occlusion_stride == 1);
+            CHECK(governor.getQuality().render_stride == 1);
+        }
+
+        WHEN("a few frames go over the budget") {
+            record(governor, sf::milliseconds(15), FrameGovernor::ESCALATE_FRAMES - 1);
+            governor.record(sf::milliseconds(5));
+            record(governor, sf::milliseconds(15), FrameGovernor::ESCALATE_FRAMES - 1);
+
+            THEN("nothing changes until enough of them are in a row") {
+                CHECK(governor.getLevel() == FrameGovernor::FULL_QUALITY);
+                governor.record(sf::milliseconds(15));
+                CHECK(governor.getLevel() == FrameGovernor::WIDE_PERCEPTION);
+            }
+        }
+
+        WHEN("the frames stay over the budget") {
+            record(governor, sf::milliseconds(15), FrameGovernor::ESCALATE_FRAMES);
+            SimulationQuality const perception(governor.getQuality());
+            record(governor, sf::milliseconds(15), FrameGovernor::ESCALATE_FRAMES);
+            SimulationQuality const waves(governor.getQuality());
+            record(governor, sf::milliseconds(15), FrameGovernor::ESCALATE_FRAMES);
+
+            THEN("perception, then waves, then rendering are degraded") {
+                CHECK(perception.perception_stretch == FrameGovernor::PERCEPTION_STRETCH);
+                CHECK(perception.wave_occlusion_stride == 1);
+                CHECK(waves.wave_occlusion_stride == FrameGovernor::WAVE_OCCLUSION_STRIDE);
+                CHECK(waves.render_stride == 1);
+                CHECK(governor.getLevel() == FrameGovernor::DECIMATED_RENDERING);
+                CHECK(governor.getQuality().render_stride == FrameGovernor::RENDER_STRIDE);
+                CHECK(governor.getLoad() == Approx(1.5));
+
+                AND_THEN("the level never goes past the last one") {
+                    record(governor, sf::milliseconds(15), 10 * FrameGovernor::ESCALATE_FRAMES);
+                    CHECK(governor.getLevel() == FrameGovernor::DECIMATED_RENDERING);
+                }
+
+                AND_THEN("only one frame in a few is drawn") {
+                    unsigned drawn(0);
+                    for (unsigned frame(0); frame < 3 * FrameGovernor::RENDER_STRIDE; ++frame) {
+                        if (governor.isDrawnFrame()) ++drawn;
+                        governor.record(sf::milliseconds(8));
+                    }
+                    CHECK(drawn == 3);
+                }
+            }
+
+            AND_WHEN("the load drops") {
+                record(governor, sf::milliseconds(8), 2 * FrameGovernor::RESTORE_FRAMES);
+
+                THEN("frames just under the budget keep the degradation") {
+                    CHECK(governor.getLevel() == FrameGovernor::DECIMATED_RENDERING);
+                }
+
+                record(governor, sf::milliseconds(2), FrameGovernor::RESTORE_FRAMES);
+
+                THEN("well under the budget, the levels are lifted one at a time") {
+                    CHECK(governor.getLevel() == FrameGovernor::COARSE_WAVES);
+                    record(governor, sf::milliseconds(2), 2 * FrameGovernor::RESTORE_FRAMES);
+                    CHECK(governor.getLevel() == FrameGovernor::FULL_QUALITY);
+                    CHECK(governor.getQuality().perception_stretch == 1);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("The governor holds the catch-up of a frame to its budget", "[FrameGovernor]")
+{
+    GIVEN("A governor with a budget of 10 ms") {
+        FrameGovernor governor;
+        governor.setBudget(BUDGET);
+
+        THEN("updates run until the frame spent its budget") {
+            CHECK(governor.canCatchUp(sf::milliseconds(9)));
+            CHECK_FALSE(governor.canCatchUp(sf::milliseconds(10)));
+        }
+
+        WHEN("the budget is removed while degraded") {
+            record(governor, sf::milliseconds(15), FrameGovernor::ESCALATE_FRAMES);
+            REQUIRE(governor.getLevel() == FrameGovernor::WIDE_PERCEPTION);
+            governor.setBudget(sf::Time::Zero);
+
+            THEN("the quality is full again and stays so whatever the cost") {
+                CHECK(governor.getLevel() == FrameGovernor::FULL_QUALITY);
+                record(governor, sf::seconds(1), 10 * FrameGovernor::ESCALATE_FRAMES);
+                CHECK(governor.getLevel() == FrameGovernor::FULL_QUALITY);
+                CHECK(governor.canCatchUp(sf::seconds(1)));
+                CHECK(governor.isDrawnFrame());
+            }
+        }
+    }
+}
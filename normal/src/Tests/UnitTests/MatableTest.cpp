@@ -25,9 +25,10 @@ SCENARIO("Gerbils' reproduction", "[Gerbil]")
     OrganicEntity*food(new Food({0,0}));
 
     // make some gerbils sufficiently mature
+    Environment env;
     auto age(sf::seconds(getAppConfig().gerbil_min_age_mating));
-    male_gerbil2->OrganicEntity::update(age);
-    female_gerbil2->OrganicEntity::update(age);
+    male_gerbil2->OrganicEntity::update(env, age);
+    female_gerbil2->OrganicEntity::update(env, age);
 
     GIVEN("two gerbils of same gender") {
         THEN("no mating") {
@@ -97,9 +98,10 @@ SCENARIO("Scorpions' reproduction", "[Scorpion]")
     OrganicEntity* male_gerbil(new Gerbil({0,0}, getAppConfig().gerbil_energy_min_mating_male, false));
     OrganicEntity*food(new Food({0,0}));
     // make some scorpions sufficiently mature
+    Environment env;
     auto age(sf::seconds(getAppConfig().scorpion_min_age_mating));
-    male_scorpion2->OrganicEntity::update(age);
-    female_scorpion2->OrganicEntity::update(age);
+    male_scorpion2->OrganicEntity::update(env, age);
+    female_scorpion2->OrganicEntity::update(env, age);
 
     GIVEN("two scorpions of same gender") {
         THEN("no mating") {
@@ -0,0 +1,111 @@
+#include <Environment/NeighbourLists.hpp>
+#include <Environment/Food.hpp>
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+double const WORLD(1000);
+double const DISTANCE(80);
+double const SKIN(40);
+double const STEP(4);
+
+double wrap(double v)
+{
+    return v < 0 ? v + WORLD : (v > WORLD ? v - WORLD : v);
+}
+
+} // anonymous
+
+SCENARIO("Neighbour lists never miss an entity in view distance", "[NeighbourLists]")
+{
+    GIVEN("A population moving, being born and dying") {
+        std::mt19937 engine(2016);
+        std::uniform_real_distribution<double> unit(0, 1);
+        auto randomEntity = [&]() {
+            return new Food(Vec2d(unit(engine) * WORLD, unit(engine) * WORLD));
+        };
+
+        std::vector<OrganicEntity*> entities;
+        for (int i(0); i < 400; ++i) {
+            entities.push_back(randomEntity());
+        }
+        NeighbourLists lists;
+        lists.setup(SKIN, WORLD);
+
+        std::size_t listed(0);
+        std::size_t missed(0);
+        for (int step(0); step < 300; ++step) {
+            // arrays as the environment keeps them
+            std::vector<double> xs, ys;
+            for (auto entity : entities) {
+                xs.push_back(entity->getPosition().x);
+                ys.push_back(entity->getPosition().y);
+            }
+
+            for (int query(0); query < 20; ++query) {
+                OrganicEntity* const owner(entities[(step * 7 + query * 13) % entities.size()]);
+                Vec2d const origin(owner->getPosition());
+                if (!lists.gather(owner, origin, DISTANCE, entities.data(), xs.data(), ys.data(), entities.size())) {
+                    continue;
+                }
+                ++listed;
+                std::vector<OrganicEntity*> const& candidates(lists.getEntities());
+                for (std::size_t i(0); i < entities.size(); ++i) {
+                    if (entities[i] == owner) continue;
+                    Vec2d const d(entities[i]->getPosition() - origin);
+                    if (d.lengthSquared() <= DISTANCE * DISTANCE
+                        and std::find(candidates.begin(), candidates.end(), entities[i]) == candidates.end()) {
+                        ++missed;
+                    }
+                }
+                for (std::size_t i(0); i < candidates.size(); ++i) {
+                    CHECK(lists.getXs()[i] == candidates[i]->getPosition().x);
+                    CHECK(lists.getYs()[i] == candidates[i]->getPosition().y);
+                }
+            }
+
+            // move, the longest move being the drift of the tick
+            double drift(0);
+            for (auto entity : entities) {
+                double const angle(unit(engine) * 6.283185307);
+                double const length(unit(engine) * STEP);
+                entity->setPosition(Vec2d(wrap(entity->getPosition().x + length * std::cos(angle)),
+                                          wrap(entity->getPosition().y + length * std::sin(angle))));
+                drift = std::max(drift, length);
+            }
+            lists.moved(drift);
+
+            // a few deaths and births
+            if (step % 5 == 0) {
+                std::vector<OrganicEntity*> dead;
+                for (int i(0); i < 3; ++i) {
+                    std::swap(entities[(step * 37 + i * 101) % entities.size()], entities.back());
+                    dead.push_back(entities.back());
+                    entities.pop_back();
+                }
+                std::sort(dead.begin(), dead.end());
+                lists.forget(dead);
+                for (auto entity : dead) delete entity;
+                for (int i(0); i < 3; ++i) {
+                    entities.push_back(randomEntity());
+                    lists.added(entities.back());
+                }
+            }
+            lists.endTick();
+        }
+
+        THEN("the lists are used and hold every entity in view distance") {
+            CHECK(listed > 0);
+            CHECK(missed == 0);
+        }
+
+        for (auto entity : entities) delete entity;
+    }
+}
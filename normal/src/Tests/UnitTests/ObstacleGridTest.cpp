@@ -0,0 +1,59 @@
+#include <Application.hpp>
+#include <Obstacle/CircularCollider.hpp>
+#include <Obstacle/ObstacleGrid.hpp>
+
+#include <catch.hpp>
+
+#include <cmath>
+#include <list>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+class Body : public CircularCollider
+{
+public:
+    Body(Vec2d const& position, double radius)
+        : CircularCollider(position, radius)
+    {
+    }
+};
+
+} // namespace
+
+SCENARIO("Obstacle grid finds the same collisions as a linear scan", "[ObstacleGrid]")
+{
+    GIVEN("Obstacles of various sizes, some across the world's edges") {
+        double const size(getAppConfig().simulation_world_size);
+        std::vector<std::unique_ptr<Body>> bodies;
+        std::list<CircularCollider*> obstacles;
+        for (int i(0); i < 60; ++i) {
+            // deterministic scatter, including positions near 0 and size
+            Vec2d const position(std::fmod(i * 97.3, size), std::fmod(i * 211.7 + size - 5, size));
+            bodies.emplace_back(new Body(position, 10 + (i % 7) * 15));
+            obstacles.push_back(bodies.back().get());
+        }
+        ObstacleGrid grid;
+        grid.build(obstacles, size);
+
+        THEN("every query returns the colliding obstacles in insertion order") {
+            for (int q(0); q < 200; ++q) {
+                Vec2d const position(std::fmod(q * 53.9, size), std::fmod(q * 131.1, size));
+                double const radius(q % 50 == 0 ? 2 * size : 1 + (q % 9) * 8);
+                Body const probe(position, 2 * radius);
+
+                std::vector<CircularCollider*> expected, found;
+                for (auto obstacle : obstacles) {
+                    if (obstacle->isColliding(probe)) expected.push_back(obstacle);
+                }
+                grid.forEachColliding(probe.getPosition(), probe.getRadius(),
+                [&found](CircularCollider* obstacle) {
+                    found.push_back(obstacle);
+                });
+                CHECK(found == expected);
+            }
+        }
+    }
+}
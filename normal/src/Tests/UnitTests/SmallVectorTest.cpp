@@ -0,0 +1,64 @@
+#include <Utility/SmallVector.hpp>
+
+#include <catch.hpp>
+
+#include <list>
+#include <vector>
+
+SCENARIO("A small vector keeps its first values inline", "[SmallVector]")
+{
+    GIVEN("An empty vector of two inline pointers") {
+        SmallVector<int*, 2> values;
+        int a(1), b(2), c(3);
+
+        THEN("it is no larger than an empty list and allocates nothing") {
+            CHECK(sizeof(values) <= sizeof(std::list<int*>));
+            CHECK(values.empty());
+            CHECK(values.heapBytes() == 0);
+        }
+
+        WHEN("two values are added") {
+            values.push_back(&a);
+            values.push_back(&b);
+
+            THEN("they stay inline") {
+                REQUIRE(values.size() == 2);
+                CHECK(values[0] == &a);
+                CHECK(values[1] == &b);
+                CHECK(values.heapBytes() == 0);
+            }
+        }
+
+        WHEN("more values are added") {
+            std::vector<int*> expected;
+            for (int i(0); i < 5; ++i) {
+                values.push_back(i % 2 ? &b : &c);
+                expected.push_back(values[i]);
+            }
+
+            THEN("they move to the heap in order") {
+                CHECK(std::vector<int*>(values.begin(), values.end()) == expected);
+                CHECK(values.heapBytes() >= 5 * sizeof(int*));
+            }
+
+            AND_WHEN("one of them is removed") {
+                values.remove(&b);
+
+                THEN("the others keep their order") {
+                    CHECK(std::vector<int*>(values.begin(), values.end()) == std::vector<int*>(3, &c));
+                }
+            }
+
+            AND_WHEN("the vector is copied and cleared") {
+                SmallVector<int*, 2> copy(values);
+                values.clear();
+
+                THEN("the copy keeps the values and the original its capacity") {
+                    CHECK(std::vector<int*>(copy.begin(), copy.end()) == expected);
+                    CHECK(values.empty());
+                    CHECK(values.heapBytes() >= 5 * sizeof(int*));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,122 @@
+#include <Environment/SpatialOrder.hpp>
+#include <Environment/Food.hpp>
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+double const WORLD(1000);
+int const SIDE(64);
+
+/// Mean distance between consecutive entities of a list, as measured by SpatialOrder
+double spread(std::list<OrganicEntity*> const& entities)
+{
+    std::vector<double> xs, ys;
+    for (auto entity : entities) {
+        xs.push_back(entity->getPosition().x);
+        ys.push_back(entity->getPosition().y);
+    }
+    double sum(0);
+    for (std::size_t i(1); i < xs.size(); ++i) {
+        sum += std::hypot(xs[i] - xs[i - 1], ys[i] - ys[i - 1]);
+    }
+    return sum / (xs.size() - 1);
+}
+
+} // anonymous
+
+SCENARIO("The Hilbert key walks the world from cell to neighbouring cell", "[SpatialOrder]")
+{
+    GIVEN("The centres of a grid of cells") {
+        double const cell(WORLD / SIDE);
+        std::vector<std::pair<std::uint32_t, Vec2d>> keyed;
+        for (int row(0); row < SIDE; ++row) {
+            for (int column(0); column < SIDE; ++column) {
+                Vec2d const centre((column + 0.5) * cell, (row + 0.5) * cell);
+                keyed.emplace_back(SpatialOrder::key(centre.x, centre.y, WORLD), centre);
+            }
+        }
+
+        WHEN("they are sorted by key") {
+            std::sort(keyed.begin(), keyed.end(),
+            [](std::pair<std::uint32_t, Vec2d> const& a, std::pair<std::uint32_t, Vec2d> const& b) {
+                return a.first < b.first;
+            });
+
+            THEN("the keys are distinct and consecutive cells are adjacent") {
+                for (std::size_t i(1); i < keyed.size(); ++i) {
+                    CHECK(keyed[i].first != keyed[i - 1].first);
+                    CHECK((keyed[i].second - keyed[i - 1].second).length() == Approx(cell));
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Entities are re-sorted once their order has decayed", "[SpatialOrder]")
+{
+    GIVEN("Entities stored in a random order") {
+        std::mt19937 engine(2016);
+        std::uniform_real_distribution<double> unit(0, 1);
+        std::list<OrganicEntity*> entities;
+        for (int i(0); i < 500; ++i) {
+            entities.push_back(new Food(Vec2d(unit(engine) * WORLD, unit(engine) * WORLD)));
+        }
+        std::vector<OrganicEntity*> const before(entities.begin(), entities.end());
+
+        SpatialOrder order;
+        order.setup(2);
+        auto observe = [&]() {
+            std::vector<double> xs, ys;
+            for (auto entity : entities) {
+                xs.push_back(entity->getPosition().x);
+                ys.push_back(entity->getPosition().y);
+            }
+            order.observe(xs.data(), ys.data(), xs.size(), WORLD);
+        };
+
+        THEN("a first sort is due, and it brings close entities together") {
+            REQUIRE(order.due());
+            double const unsorted(spread(entities));
+            order.sort(entities, WORLD);
+            CHECK(order.getSorts() == 1);
+            CHECK(spread(entities) * 5 < unsorted);
+
+            std::vector<OrganicEntity*> after(entities.begin(), entities.end());
+            std::vector<OrganicEntity*> sortedBefore(before);
+            std::sort(after.begin(), after.end());
+            std::sort(sortedBefore.begin(), sortedBefore.end());
+            CHECK(after == sortedBefore);
+
+            AND_THEN("the next one is only due once the entities have scattered") {
+                observe();
+                CHECK_FALSE(order.due());
+                observe();
+                CHECK_FALSE(order.due());
+
+                for (auto entity : entities) {
+                    entity->setPosition(Vec2d(unit(engine) * WORLD, unit(engine) * WORLD));
+                }
+                observe();
+                CHECK(order.due());
+            }
+        }
+
+        WHEN("the threshold is 0") {
+            order.setup(0);
+
+            THEN("no sort is ever due") {
+                CHECK_FALSE(order.due());
+            }
+        }
+
+        for (auto entity : entities) delete entity;
+    }
+}
@@ -0,0 +1,142 @@
+#include <Animal/SteeringBatch.hpp>
+#include <Utility/Constants.hpp>
+
+#include <catch.hpp>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+double const WORLD(1000);
+double const DT(0.05);
+double const TOLERANCE(1e-9);
+
+struct Move
+{
+    Vec2d position;
+    Vec2d direction;
+    double speed;
+    double max_speed;
+    double mass;
+    Vec2d steering;
+    bool seek;
+};
+
+/// clamping() of CircularCollider.cpp
+Vec2d wrapped(Vec2d const& v)
+{
+    Vec2d result(v);
+    if (v.x < 0) result.x += WORLD;
+    if (v.x > WORLD) result.x -= WORLD;
+    if (v.y > WORLD) result.y -= WORLD;
+    if (v.y < 0) result.y += WORLD;
+    return result;
+}
+
+/// CircularCollider::directionTo()
+Vec2d directionTo(Vec2d const& from, Vec2d const& target)
+{
+    Vec2d const to(wrapped(target));
+    double min(10000);
+    Vec2d vector;
+    for (int i(-1); i <= 1; ++i) {
+        for (int j(-1); j <= 1; ++j) {
+            Vec2d const copy(to.x + i * WORLD, to.y + j * WORLD);
+            if ((copy - from).length() < min) {
+                min = (copy - from).length();
+                vector = copy - from;
+            }
+        }
+    }
+    return vector;
+}
+
+/// Animal::force() followed by Animal::moveToVec2dForce(), one animal at a time
+Move scalarMove(Move move)
+{
+    Vec2d force(move.steering);
+    if (move.seek) {
+        Vec2d const to(directionTo(move.position, move.steering));
+        if (std::abs(to.length()) >= EPSILON) {
+            double const brake(to.length() / ANIMAL_DECELERATION);
+            double const speed(brake <= move.max_speed ? brake : move.max_speed);
+            force = to / to.length() * speed - move.speed * move.direction;
+        } else {
+            force = move.direction;
+        }
+    }
+    Vec2d const acceleration(force / move.mass);
+    Vec2d velocity(move.speed * move.direction + acceleration * DT);
+    move.direction = std::abs(velocity.length()) >= EPSILON ? velocity / velocity.length() : velocity;
+    if (velocity.length() > move.max_speed) velocity = move.direction * move.max_speed;
+    move.position = wrapped(move.position + velocity * DT);
+    move.speed = velocity.length();
+    return move;
+}
+
+} // anonymous
+
+SCENARIO("The steering batch moves animals like the scalar code", "[SteeringBatch]")
+{
+    GIVEN("A population seeking targets or pushed by forces") {
+        std::mt19937 engine(2016);
+        std::uniform_real_distribution<double> unit(0, 1);
+        std::vector<Move> moves;
+        for (int i(0); i < 301; ++i) { // odd, for the scalar tail
+            double const angle(unit(engine) * TAU);
+            Move move;
+            move.position = Vec2d(unit(engine) * WORLD, unit(engine) * WORLD);
+            move.direction = Vec2d(std::cos(angle), std::sin(angle));
+            move.speed = unit(engine) * 100;
+            move.max_speed = 20 + unit(engine) * 300;
+            move.mass = 0.5 + unit(engine) * 3;
+            move.seek = i % 3 != 0;
+            if (move.seek) {
+                // around the animal, across the borders of the world too
+                move.steering = move.position + Vec2d(unit(engine) - 0.5, unit(engine) - 0.5) * 400;
+                if (i % 17 == 0) move.steering = move.position; // target reached
+            } else {
+                move.steering = Vec2d(unit(engine) - 0.5, unit(engine) - 0.5) * 2000;
+            }
+            if (i % 23 == 0) move.speed = 0;
+            moves.push_back(move);
+        }
+
+        SteeringBatch batch;
+        for (auto const& move : moves) {
+            if (move.seek) {
+                batch.seek(nullptr, move.position, move.direction, move.speed, move.max_speed, move.mass, move.steering);
+            } else {
+                batch.push(nullptr, move.position, move.direction, move.speed, move.max_speed, move.mass, move.steering);
+            }
+        }
+
+        WHEN("the batch is integrated") {
+            batch.integrate(DT, WORLD);
+
+            THEN("each animal ends where the scalar code puts it") {
+                REQUIRE(batch.size() == moves.size());
+                for (std::size_t i(0); i < moves.size(); ++i) {
+                    Move const expected(scalarMove(moves[i]));
+                    CHECK(batch.getPosition(i).x == Approx(expected.position.x).epsilon(TOLERANCE));
+                    CHECK(batch.getPosition(i).y == Approx(expected.position.y).epsilon(TOLERANCE));
+                    CHECK(batch.getDirection(i).x == Approx(expected.direction.x).epsilon(TOLERANCE));
+                    CHECK(batch.getDirection(i).y == Approx(expected.direction.y).epsilon(TOLERANCE));
+                    CHECK(batch.getSpeed(i) == Approx(expected.speed).epsilon(TOLERANCE));
+                }
+            }
+        }
+
+        WHEN("the batch is cleared") {
+            batch.clear();
+
+            THEN("it is empty and closed") {
+                CHECK(batch.size() == 0);
+                CHECK_FALSE(batch.isOpen());
+            }
+        }
+    }
+}
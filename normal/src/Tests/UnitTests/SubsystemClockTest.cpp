@@ -0,0 +1,54 @@
+#include <Environment/SubsystemClock.hpp>
+
+#include <catch.hpp>
+
+SCENARIO("A subsystem runs at its own rate with all the elapsed time", "[SubsystemClock]")
+{
+    GIVEN("A clock with a period of 100 ms, ticked every 30 ms") {
+        SubsystemClock clock;
+        clock.setPeriod(sf::milliseconds(100));
+
+        std::size_t runs(0);
+        sf::Time integrated(sf::Time::Zero);
+        for (int tick(0); tick < 100; ++tick) {
+            if (clock.advance(sf::milliseconds(30))) {
+                ++runs;
+                sf::Time const elapsed(clock.consume());
+                CHECK(elapsed == sf::milliseconds(120));
+                integrated += elapsed;
+            }
+        }
+
+        THEN("it runs every fourth tick and integrates all the time") {
+            CHECK(runs == 25);
+            CHECK(integrated == sf::milliseconds(3000));
+            CHECK_FALSE(clock.due());
+        }
+    }
+
+    GIVEN("A clock with no period") {
+        SubsystemClock clock;
+
+        THEN("it runs on every tick with the tick's time") {
+            for (int tick(1); tick <= 5; ++tick) {
+                REQUIRE(clock.advance(sf::milliseconds(tick)));
+                CHECK(clock.consume() == sf::milliseconds(tick));
+            }
+        }
+    }
+
+    GIVEN("A clock that accumulated some time") {
+        SubsystemClock clock;
+        clock.setPeriod(sf::seconds(1));
+        clock.advance(sf::milliseconds(900));
+
+        WHEN("it is reset") {
+            clock.reset();
+
+            THEN("the time accumulated so far is forgotten") {
+                CHECK_FALSE(clock.advance(sf::milliseconds(900)));
+                CHECK(clock.advance(sf::milliseconds(100)));
+            }
+        }
+    }
+}
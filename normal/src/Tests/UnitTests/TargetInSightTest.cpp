@@ -9,7 +9,9 @@
 #include <Utility/Constants.hpp>
 #include <Config.hpp>
 #include <catch.hpp>
+#include <Random/Uniform.hpp>
 #include <iostream>
+#include <vector>
 #define STEP 3
 
 #if STEP >= 3
@@ -53,96 +55,57 @@ public:
     }
 #endif
 #if STEP >= 3
-    double getViewRange() const override
+    const double& getViewRange() const override
     {
-        return ANIMAL_VIEW_RANGE;
+        return viewRange;
     }
 
-    double getViewDistance() const override
+    const double& getViewDistance() const override
     {
-        return ANIMAL_VIEW_DISTANCE;
+        return viewDistance;
     }
 
-    bool eatable(const OrganicEntity*) const override
-    {
-        return false;
-    }
-    bool eatableDispatch(const Scorpion*) const override
-    {
-        return false;
-    }
-    bool eatableDispatch(const Gerbil*) const override
-    {
-        return false;
-    }
-    bool eatableDispatch(const Food*) const override
-    {
-        return false;
-    }
-    bool matable(const OrganicEntity*) const  override
-    {
-        return false;
-    }
-    bool matableDispatch(const Scorpion*) const override
+    bool isGerbil() const override
     {
         return false;
     }
-    bool matableDispatch(const Gerbil*) const override
+    bool isScorpion() const override
     {
         return false;
     }
-    bool matableDispatch(const Food*) const override
+    bool isFood() const override
     {
         return false;
     }
 
-    void meet(OrganicEntity*)  override
+    const double& getStandardMaxSpeed() const override
     {
-        /* does nothing */
+        return zero;
     }
-    void meetDispatch(Scorpion*) override
+    const double& getMass() const override
     {
-        /* does nothing */
+        return zero;
     }
-    void meetDispatch(Gerbil*) override
+    const double& getRandomWalkJitter() const override
     {
-        /* does nothing */
+        return zero;
     }
-    void meetDispatch (Food*) override
+    const double& getRandomWalkRadius() const override
     {
-        /* does nothing */
+        return zero;
     }
-    double getStandardMaxSpeed() const override
+    const double& getRandomWalkDistance() const override
     {
-        return 0.;
+        return zero;
     }
-    double getMass() const override
+    const sf::Texture& getTexture() const override
     {
-        return 0.;
-    }
-    double getEnergyLostFactor() const override
-    {
-        return 0.;
+        return getAppTexture(getAppConfig().gerbil_texture_male);
     }
 
-    double getRandomWalkJitter() const override
-    {
-        return 0.;
-    }
-    double getRandomWalkRadius() const override
-    {
-        return 0.;
-    }
-
-    double getRandomWalkDistance() const override
-    {
-        return 0.;
-    }
-
-    void giveBirth(unsigned int)
-    {
-        /*does nothing */
-    }
+    double viewRange = ANIMAL_VIEW_RANGE;
+    double viewDistance = ANIMAL_VIEW_DISTANCE;
+    double const zero = 0.;
 #endif
 };
 
@@ -253,3 +216,60 @@ SCENARIO("Animal interacts with target", "[Animal]")
         }
     }
 }
+
+SCENARIO("Batched view cone test", "[Animal]")
+{
+    // Reference: the angular test written with a cosine and a square root
+    auto reference = [](DummyAnimal const& animal, Vec2d const& target) {
+        Vec2d const d(target - animal.getPosition());
+        return d.lengthSquared() <= animal.viewDistance * animal.viewDistance
+               and animal.getDirection().dot(d.normalised())
+               >= std::cos((animal.viewRange + ANIMAL_VIEW_RANGE_EPSILON) / 2);
+    };
+    // Points closer than this to the cone's border may fall either side
+    auto onBorder = [](DummyAnimal const& animal, Vec2d const& target) {
+        Vec2d const d(target - animal.getPosition());
+        double const cosine(animal.getDirection().dot(d.normalised()));
+        double const cosHalf(std::cos((animal.viewRange + ANIMAL_VIEW_RANGE_EPSILON) / 2));
+        return std::abs(d.length() - animal.viewDistance) < 1e-9
+               or std::abs(cosine - cosHalf) < 1e-9;
+    };
+
+    std::vector<double> const ranges { 60 * DEG_TO_RAD, 180 * DEG_TO_RAD, 300 * DEG_TO_RAD, 2 * PI };
+
+    for (double range : ranges) {
+        GIVEN("An animal with a view range of " + std::to_string(range / DEG_TO_RAD) + " degrees") {
+            DummyAnimal animal({ 500, 500 }, Polar2Cartesian(uniform(-PI, PI), 1));
+            animal.viewRange = range;
+
+            std::vector<double> xs, ys;
+            for (int i(0); i < 1001; ++i) { // odd count: exercises the tail
+                xs.push_back(uniform(0.0, 1000.0));
+                ys.push_back(uniform(0.0, 1000.0));
+            }
+            ViewCone const cone(animal.getPosition(), animal.getDirection(),
+                                std::cos((range + ANIMAL_VIEW_RANGE_EPSILON) / 2), animal.viewDistance);
+            std::vector<std::uint32_t> selected(xs.size());
+            selected.resize(cone.select(xs.data(), ys.data(), xs.size(), selected.data()));
+
+            THEN("the batch selects exactly the targets seen one by one") {
+                std::size_t next(0);
+                for (std::size_t i(0); i < xs.size(); ++i) {
+                    bool const batched(next < selected.size() and selected[next] == i);
+                    if (batched) ++next;
+                    CHECK(batched == animal.isTargetInSight({ xs[i], ys[i] }));
+                }
+                CHECK(next == selected.size());
+            }
+
+            THEN("the targets seen are the ones of the trigonometric definition") {
+                for (std::size_t i(0); i < xs.size(); ++i) {
+                    Vec2d const target(xs[i], ys[i]);
+                    if (!onBorder(animal, target)) {
+                        CHECK(animal.isTargetInSight(target) == reference(animal, target));
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,88 @@
+#include <Environment/TimerWheel.hpp>
+
+#include <catch.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+
+struct Fired
+{
+    int kind;
+    sf::Int64 at; ///< wheel time when fired, in microseconds
+};
+
+} // anonymous
+
+SCENARIO("Timer wheel fires every timer once, never early", "[TimerWheel]")
+{
+    GIVEN("Timers with delays spanning every level of the wheel") {
+        TimerWheel wheel;
+        std::vector<sf::Int64> deadlines;
+        for (int i(0); i < 400; ++i) {
+            // from sub-millisecond to about 5 hours
+            sf::Int64 const delay((i * i * i * 2654435761LL) % 18000000000LL + (i % 5) * 300);
+            wheel.schedule(sf::microseconds(delay), nullptr, i);
+            deadlines.push_back(delay);
+        }
+        CHECK(wheel.size() == deadlines.size());
+
+        WHEN("time moves forward by uneven steps") {
+            std::vector<Fired> fired;
+            auto record = [&](OrganicEntity*, int kind) {
+                fired.push_back({ kind, wheel.getTime().asMicroseconds() });
+            };
+            sf::Int64 step(0);
+            while (wheel.getTime() < sf::microseconds(18000000000LL + 2000)) {
+                step = (step * 7 + 13) % 40000 + 1;
+                wheel.advance(sf::microseconds(step < 20000 ? step : step * 5000), record);
+            }
+
+            THEN("each fires once, in deadline order, less than a step late") {
+                REQUIRE(fired.size() == deadlines.size());
+                CHECK(wheel.size() == 0);
+                for (std::size_t i(0); i < fired.size(); ++i) {
+                    CHECK(fired[i].at >= deadlines[fired[i].kind]);
+                    if (i > 0) CHECK(deadlines[fired[i - 1].kind] <= deadlines[fired[i].kind] + 1000);
+                }
+            }
+        }
+    }
+
+    GIVEN("Two timers, one of them cancelled") {
+        TimerWheel wheel;
+        TimerWheel::Handle kept(wheel.schedule(sf::seconds(1), nullptr, 1));
+        TimerWheel::Handle dropped(wheel.schedule(sf::seconds(1), nullptr, 2));
+        wheel.cancel(dropped);
+
+        THEN("the cancelled one is neither pending nor fired") {
+            CHECK(dropped == TimerWheel::NONE);
+            CHECK(wheel.isPending(kept));
+            std::vector<int> fired;
+            wheel.advance(sf::seconds(2), [&](OrganicEntity*, int kind) {
+                fired.push_back(kind);
+            });
+            CHECK(fired == std::vector<int>({ 1 }));
+            CHECK(!wheel.isPending(kept));
+        }
+    }
+
+    GIVEN("A timer scheduled from a firing timer") {
+        TimerWheel wheel;
+        wheel.schedule(sf::milliseconds(10), nullptr, 1);
+        std::vector<int> fired;
+
+        WHEN("both fall within one advance") {
+            wheel.advance(sf::milliseconds(100), [&](OrganicEntity*, int kind) {
+                fired.push_back(kind);
+                if (kind == 1) wheel.schedule(sf::milliseconds(20), nullptr, 2);
+            });
+
+            THEN("both fire") {
+                CHECK(fired == std::vector<int>({ 1, 2 }));
+            }
+        }
+    }
+}
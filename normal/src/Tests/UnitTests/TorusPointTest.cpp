@@ -0,0 +1,76 @@
+#include <Utility/TorusPoint.hpp>
+
+#include <catch.hpp>
+
+#include <cmath>
+#include <random>
+
+namespace
+{
+
+double const WORLD(1000);
+
+/// Shortest vector from a to b on the torus, as the nine images of CircularCollider
+Vec2d minimumImage(Vec2d const& a, Vec2d const& b)
+{
+    Vec2d best(b - a);
+    for (int i(-1); i <= 1; ++i) {
+        for (int j(-1); j <= 1; ++j) {
+            Vec2d const image(b + Vec2d(i * WORLD, j * WORLD) - a);
+            if (image.lengthSquared() < best.lengthSquared()) best = image;
+        }
+    }
+    return best;
+}
+
+} // anonymous
+
+SCENARIO("Fixed point positions wrap around the torus for free", "[TorusPoint]")
+{
+    double const step(WORLD / 4294967296.0);
+
+    GIVEN("Points in and out of the world") {
+        THEN("they are converted back to within a step, wrapped into the world") {
+            CHECK(TorusPoint(Vec2d(250, 750), WORLD).toVec2d(WORLD).x == Approx(250).epsilon(step));
+            CHECK(TorusPoint(Vec2d(250, 750), WORLD).toVec2d(WORLD).y == Approx(750).epsilon(step));
+            CHECK(TorusPoint(Vec2d(-10, 1010), WORLD).toVec2d(WORLD).x == Approx(990).epsilon(step));
+            CHECK(TorusPoint(Vec2d(-10, 1010), WORLD).toVec2d(WORLD).y == Approx(10).epsilon(step));
+            CHECK(TorusPoint(Vec2d(WORLD, 0), WORLD) == TorusPoint(Vec2d(0, 0), WORLD));
+        }
+    }
+
+    GIVEN("A point near a corner") {
+        TorusPoint point(Vec2d(995, 3), WORLD);
+
+        WHEN("it moves across the borders") {
+            point.move(Vec2d(10, -5), WORLD);
+
+            THEN("it comes in from the other sides") {
+                CHECK(point.toVec2d(WORLD).x == Approx(5));
+                CHECK(point.toVec2d(WORLD).y == Approx(998));
+            }
+        }
+
+        THEN("the way to the opposite corner goes across the borders") {
+            Vec2d const way(point.to(TorusPoint(Vec2d(4, 996), WORLD), WORLD));
+            CHECK(way.x == Approx(9));
+            CHECK(way.y == Approx(-7));
+        }
+    }
+
+    GIVEN("Random pairs of points") {
+        std::mt19937 engine(2016);
+        std::uniform_real_distribution<double> unit(0, 1);
+        double worst(0);
+        for (int i(0); i < 10000; ++i) {
+            Vec2d const a(unit(engine) * WORLD, unit(engine) * WORLD);
+            Vec2d const b(unit(engine) * WORLD, unit(engine) * WORLD);
+            Vec2d const way(TorusPoint(a, WORLD).to(TorusPoint(b, WORLD), WORLD));
+            worst = std::max(worst, (way - minimumImage(a, b)).length());
+        }
+
+        THEN("the integer difference is the minimum image, to a step") {
+            CHECK(worst <= 2 * step);
+        }
+    }
+}
@@ -6,6 +6,10 @@
 
 #include <Tests/UnitTests/CheckUtility.hpp>
 #include <Utility/Vec2d.hpp>
+#include <Utility/FastMath.hpp>
+
+#include <algorithm>
+#include <type_traits>
 
 SCENARIO("Constructing Vec2d", "[Vec2d]")
 {
@@ -75,6 +79,23 @@ SCENARIO("Constructing Vec2d", "[Vec2d]")
     }
 }
 
+SCENARIO("Vec2d is a constexpr value type", "[Vec2d]")
+{
+    GIVEN("Vectors computed at compile time") {
+        constexpr Vec2d a(1, 2);
+        constexpr Vec2d b(a * 3 - Vec2d(1, 1) + a.normal() / 2);
+        static_assert(b.x == 3 and b.y == 4.5, "arithmetic is constexpr");
+        static_assert(a.dot(b) == 12 and b.isLongerThan(5), "products are constexpr");
+        static_assert(a != b and a == Vec2d(1, 2), "comparisons are constexpr");
+
+        THEN("it is trivially copyable, the size of its two coordinates") {
+            CHECK(std::is_trivially_copyable<Vec2d>::value);
+            CHECK(sizeof(Vec2d) == 2 * sizeof(double));
+            CHECK(distanceSquared(a, b) == Approx(2 * 2 + 2.5 * 2.5));
+        }
+    }
+}
+
 SCENARIO("Assigning Vec2d", "[Vec2d]")
 {
     GIVEN("A vector") {
@@ -368,3 +389,59 @@ SCENARIO("Using vector algebra", "[Vec2d]")
         }
     }
 }
+
+SCENARIO("Fast-math approximations stay within their bounds", "[Vec2d]")
+{
+    GIVEN("Vectors all around the circle, of lengths from 1e-6 to 1e6") {
+        double worstInverseSqrt(0);
+        double worstAtan2(0);
+        double worstSinCos(0);
+        for (int i(0); i < 20000; ++i) {
+            double const angle(-4 * PI + i * (8 * PI / 20000));
+            double const length(std::pow(10.0, -6 + 12.0 * i / 20000));
+            Vec2d const v(length * std::cos(angle), length * std::sin(angle));
+
+            double const squared(v.lengthSquared());
+            worstInverseSqrt = std::max(worstInverseSqrt,
+                                        std::abs(fastInverseSqrt(squared) * std::sqrt(squared) - 1));
+            worstAtan2 = std::max(worstAtan2, std::abs(fastAtan2(v.y, v.x) - std::atan2(v.y, v.x)));
+
+            double sine, cosine;
+            fastSinCos(angle, sine, cosine);
+            worstSinCos = std::max(worstSinCos, std::max(std::abs(sine - std::sin(angle)),
+                                                         std::abs(cosine - std::cos(angle))));
+        }
+
+        THEN("the errors are below the documented bounds") {
+            CHECK(worstInverseSqrt <= FAST_INVERSE_SQRT_MAX_ERROR);
+            CHECK(worstAtan2 <= FAST_ATAN2_MAX_ERROR);
+            CHECK(worstSinCos <= FAST_SINCOS_MAX_ERROR);
+        }
+    }
+
+    GIVEN("The axes and the null vector") {
+        THEN("atan2 is exact on them") {
+            CHECK(fastAtan2(0, 1) == 0);
+            CHECK(fastAtan2(1, 0) == Approx(PI / 2).epsilon(1e-9));
+            CHECK(fastAtan2(0, -1) == Approx(PI).epsilon(1e-9));
+            CHECK(fastAtan2(0, 0) == 0);
+        }
+    }
+
+    GIVEN("A vector and a length") {
+        Vec2d const v(3, 4);
+
+        THEN("comparing squared lengths agrees with the lengths") {
+            CHECK(v.isLongerThan(4.99));
+            CHECK_FALSE(v.isLongerThan(5.01));
+            CHECK(distanceSquared(v, Vec2d(0, 0)) == Approx(25));
+        }
+
+        THEN("fromAngle() gives back the angle of a unit vector") {
+            Vec2d const unit(Vec2d::fromAngle(v.angle()));
+            CHECK_APPROX_EQUAL(unit.x, 0.6);
+            CHECK_APPROX_EQUAL(unit.y, 0.8);
+            CHECK_APPROX_EQUAL(unit.length(), 1);
+        }
+    }
+}
@@ -0,0 +1,38 @@
+#include <Application.hpp>
+#include <Animal/NeuronalScorpion/WaveGerbil.hpp>
+#include <Config.hpp>
+#include <Environment/Environment.hpp>
+#include <JSON/JSON.hpp>
+#include <Utility/Constants.hpp>
+
+#include <catch.hpp>
+
+#include <cmath>
+
+SCENARIO("A wave gerbil emits a wave every period, whatever its state", "[WaveGerbil]")
+{
+    GIVEN("An adult wave gerbil alone in a world where waves never fade out") {
+        j::Value json(getAppConfig().getJsonRead());
+        json["simulation"]["wave"]["intensity"]["threshold"] = j::number(0.0);
+        Config config(json);
+        WorldBinding bindConfig(config);
+
+        Environment env;
+        WorldBinding bindWorld(config, env);
+        double const size(config.simulation_world_size);
+        env.addEntity(new WaveGerbil(Vec2d(size / 2, size / 2), 10 * config.gerbil_energy_initial, true));
+
+        WHEN("it lives three periods of waves") {
+            sf::Time const dt(sf::seconds(0.05));
+            // the clock restarts on each wave, so a period takes a whole number of updates
+            int const perWave(std::ceil(1.0 / config.wave_gerbil_frequency / dt.asSeconds()));
+            for (int i(0); i < 3 * perWave; ++i) {
+                env.update(dt);
+            }
+
+            THEN("it has emitted three waves") {
+                CHECK(env.fetchData(s::WAVES)[s::WAVES] == 3);
+            }
+        }
+    }
+}
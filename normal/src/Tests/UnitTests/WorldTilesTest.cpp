@@ -0,0 +1,185 @@
+#include <Application.hpp>
+#include <Animal/Gerbil.hpp>
+#include <Config.hpp>
+#include <Environment/Environment.hpp>
+#include <Environment/WorldTiles.hpp>
+#include <Environment/Food.hpp>
+#include <JSON/JSON.hpp>
+#include <Random/RandomGenerator.hpp>
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+double const WORLD(1000);
+double const HALO(60);
+
+/// Distance along one axis around the torus
+double wrapped(double a, double b)
+{
+    double const d(std::abs(a - b));
+    return std::min(d, WORLD - d);
+}
+
+/// Distance from a coordinate to the interval [low, high) of a tile, around the torus
+double toInterval(double x, double low, double high)
+{
+    if (x >= low and x < high) return 0;
+    return std::min(wrapped(x, low), wrapped(x, high));
+}
+
+/// Positions and energies of the first gerbils, then the numbers of gerbils
+/// and food, after half a minute of a seeded world updated tile by tile on a
+/// number of workers
+std::vector<double> simulateTiles(int workers)
+{
+    j::Value json(getAppConfig().getJsonRead());
+    json["simulation"]["world"]["tiles"] = j::number(4);
+    json["simulation"]["world"]["tile workers"] = j::number(workers);
+    Config config(json);
+    WorldBinding bindConfig(config);
+    seedRandomGenerator(2016);
+
+    Environment env;
+    WorldBinding bindWorld(config, env);
+    double const size(config.simulation_world_size);
+    std::mt19937 engine(2016);
+    std::uniform_real_distribution<double> unit(0, 1);
+    // the food is eaten and the gerbils mate across the borders of the tiles
+    std::vector<Animal*> gerbils;
+    for (int i(0); i < 200; ++i) {
+        Gerbil* const gerbil(new Gerbil(Vec2d(unit(engine) * size, unit(engine) * size),
+                                        10 * config.gerbil_energy_initial, i % 2 == 0, sf::seconds(1e6)));
+        gerbils.push_back(gerbil);
+        env.addEntity(gerbil);
+    }
+    for (int i(0); i < 200; ++i) {
+        env.addEntity(new Food(Vec2d(unit(engine) * size, unit(engine) * size)));
+    }
+
+    for (int i(0); i < 600; ++i) {
+        env.update(sf::seconds(0.05));
+    }
+
+    std::vector<double> result;
+    for (auto gerbil : gerbils) {
+        result.push_back(gerbil->getPosition().x);
+        result.push_back(gerbil->getPosition().y);
+        result.push_back(gerbil->getEnergy());
+    }
+    result.push_back(env.countGerbils());
+    result.push_back(env.countFood());
+    return result;
+}
+
+} // anonymous
+
+SCENARIO("Every tile holds its own entities and a halo around it", "[WorldTiles]")
+{
+    GIVEN("Entities spread over a world cut into 4 x 4 tiles") {
+        std::mt19937 engine(2016);
+        std::uniform_real_distribution<double> unit(0, 1);
+        std::vector<OrganicEntity*> entities;
+        std::vector<double> xs, ys;
+        for (int i(0); i < 400; ++i) {
+            double const x(unit(engine) * WORLD), y(unit(engine) * WORLD);
+            entities.push_back(new Food(Vec2d(x, y)));
+            xs.push_back(x);
+            ys.push_back(y);
+        }
+
+        WorldTiles tiles;
+        tiles.setup(4, 1);
+        REQUIRE(tiles.active());
+        tiles.assign(entities.data(), xs.data(), ys.data(), entities.size(), WORLD, HALO);
+        REQUIRE(tiles.getTiles().size() == 16);
+
+        THEN("each entity is owned by the tile it stands in, and only by it") {
+            std::vector<OrganicEntity*> owned;
+            for (std::size_t t(0); t < 16; ++t) {
+                auto const& tile(tiles.getTiles()[t]);
+                double const low_x((t % 4) * WORLD / 4), low_y((t / 4) * WORLD / 4);
+                for (std::size_t i(0); i < tile.owned.size(); ++i) {
+                    REQUIRE(tile.entities[i] == tile.owned[i]);
+                    CHECK(tile.xs[i] >= low_x);
+                    CHECK(tile.xs[i] < low_x + WORLD / 4);
+                    CHECK(tile.ys[i] >= low_y);
+                    CHECK(tile.ys[i] < low_y + WORLD / 4);
+                }
+                owned.insert(owned.end(), tile.owned.begin(), tile.owned.end());
+            }
+            std::sort(owned.begin(), owned.end());
+            std::vector<OrganicEntity*> all(entities);
+            std::sort(all.begin(), all.end());
+            CHECK(owned == all);
+        }
+
+        THEN("the halo holds, once, every other entity within its width, across the borders of the world") {
+            for (std::size_t t(0); t < 16; ++t) {
+                auto const& tile(tiles.getTiles()[t]);
+                double const low_x((t % 4) * WORLD / 4), low_y((t / 4) * WORLD / 4);
+                std::vector<OrganicEntity*> expected;
+                for (std::size_t i(0); i < entities.size(); ++i) {
+                    if (toInterval(xs[i], low_x, low_x + WORLD / 4) <= HALO
+                        and toInterval(ys[i], low_y, low_y + WORLD / 4) <= HALO) {
+                        expected.push_back(entities[i]);
+                    }
+                }
+                std::vector<OrganicEntity*> held(tile.entities);
+                std::sort(held.begin(), held.end());
+                std::sort(expected.begin(), expected.end());
+                CHECK(std::adjacent_find(held.begin(), held.end()) == held.end());
+                CHECK(std::includes(held.begin(), held.end(), expected.begin(), expected.end()));
+            }
+        }
+
+        WHEN("the tiles are run on several workers") {
+            tiles.setup(4, 3);
+            std::vector<std::atomic<int>> visits(16);
+            for (auto& count : visits) count = 0;
+            std::atomic<bool> consistent(true);
+            tiles.run([&](WorldTiles::Tile& tile) {
+                std::size_t const index(&tile - tiles.getTiles().data());
+                ++visits[index];
+                if (WorldTiles::current() != &tile) consistent = false;
+            });
+
+            THEN("each tile is run once, as the current tile of its thread") {
+                for (auto const& count : visits) CHECK(count == 1);
+                CHECK(consistent);
+                CHECK(WorldTiles::current() == nullptr);
+            }
+        }
+
+        WHEN("there is a single tile per side") {
+            tiles.setup(1, 4);
+
+            THEN("the world is not split") {
+                CHECK_FALSE(tiles.active());
+            }
+        }
+
+        for (auto entity : entities) delete entity;
+    }
+}
+
+SCENARIO("A world updated tile by tile does not depend on the number of workers", "[WorldTiles]")
+{
+    GIVEN("The same seeded world, cut into 4 x 4 tiles") {
+        WHEN("it is updated on one worker, then on four") {
+            std::vector<double> const alone(simulateTiles(1));
+            std::vector<double> const shared(simulateTiles(4));
+
+            THEN("the gerbils end where they did, with the same energies") {
+                CHECK(alone == shared);
+            }
+        }
+    }
+}
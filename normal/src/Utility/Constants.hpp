@@ -9,10 +9,10 @@
 #include <string>
 
 // Numerical constants
-double const DEG_TO_RAD = 0.0174532925; ///< Degree to Radian conversion constant
-double const TAU = 6.283185307;         ///< TAU constant (= 2 * PI)
-double const PI = 3.141592654;          ///< PI constant
-double const EPSILON = 1e-8;            ///< a small epsilon value
+constexpr double DEG_TO_RAD = 0.0174532925; ///< Degree to Radian conversion constant
+constexpr double TAU = 6.283185307;         ///< TAU constant (= 2 * PI)
+constexpr double PI = 3.141592654;          ///< PI constant
+constexpr double EPSILON = 1e-8;            ///< a small epsilon value
 
 
 // Ad'hoc constants
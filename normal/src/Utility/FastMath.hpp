@@ -0,0 +1,101 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+
+/*
+ * Approximations of the libm calls made by Vec2d, used in its place when
+ * the code is built with INFOSV_FAST_MATH (scons fastmath=1). They are
+ * always available, so that their error bounds can be tested whatever the
+ * build: each FAST_*_MAX_ERROR below is checked by Vec2dTest.
+ */
+
+/// Bound on the relative error of fastInverseSqrt()
+double const FAST_INVERSE_SQRT_MAX_ERROR = 1e-12;
+
+/// Bound on the absolute error of fastAtan2(), in radians
+double const FAST_ATAN2_MAX_ERROR = 1e-7;
+
+/// Bound on the absolute error of fastSinCos() for angles in [-4 PI, 4 PI]
+double const FAST_SINCOS_MAX_ERROR = 1e-8;
+
+/**
+ * @brief 1 / sqrt(x) for x > 0
+ *
+ * Refines the 12 bit hardware estimate (or the bit-level guess when SSE
+ * is not available) with Newton steps instead of going through the
+ * divider and the square root unit. Values out of the range of float
+ * fall back to the exact computation.
+ */
+inline double fastInverseSqrt(double x)
+{
+    if (!(x > 1e-30 and x < 1e30)) return 1.0 / std::sqrt(x);
+
+    double const half(0.5 * x);
+#ifdef __SSE__
+    double y(_mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(static_cast<float>(x)))));
+    y *= 1.5 - half * y * y;
+    y *= 1.5 - half * y * y;
+#else
+    std::uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    bits = 0x5fe6eb50c7b537a9ull - (bits >> 1);
+    double y;
+    std::memcpy(&y, &bits, sizeof(y));
+    for (int step(0); step < 4; ++step) {
+        y *= 1.5 - half * y * y;
+    }
+#endif
+    return y;
+}
+
+/**
+ * @brief atan2(y, x), in [-PI, PI]
+ *
+ * Folds the vector in the first octant and evaluates the odd minimax
+ * polynomial of Abramowitz and Stegun (4.4.49) for atan on [0, 1].
+ */
+inline double fastAtan2(double y, double x)
+{
+    double const ax(std::abs(x));
+    double const ay(std::abs(y));
+    double const big(ax > ay ? ax : ay);
+    if (big == 0) return 0;
+
+    double const t((ax > ay ? ay : ax) / big);
+    double const t2(t * t);
+    double a(t * (1 + t2 * (-0.3333314528 + t2 * (0.1999355085 + t2 * (-0.1420889944
+              + t2 * (0.1065626393 + t2 * (-0.0752896400 + t2 * (0.0429096138
+              + t2 * (-0.0161657367 + t2 * 0.0028662257)))))))));
+
+    if (ay > ax) a = 1.57079632679489662 - a;
+    if (x < 0) a = 3.14159265358979324 - a;
+    return y < 0 ? -a : a;
+}
+
+/**
+ * @brief sin and cos of an angle, in radians
+ *
+ * Reduces the angle to [-PI/4, PI/4] around the nearest multiple of PI/2
+ * and evaluates the Taylor polynomials there; the error grows with the
+ * size of the angle, through the reduction.
+ */
+inline void fastSinCos(double angle, double& sine, double& cosine)
+{
+    double const quarters(std::floor(angle * 0.636619772367581343 + 0.5));
+    double const r(angle - quarters * 1.57079632679489662);
+    double const r2(r * r);
+    double const s(r * (1 + r2 * (-1.0 / 6 + r2 * (1.0 / 120 + r2 * (-1.0 / 5040 + r2 * (1.0 / 362880))))));
+    double const c(1 + r2 * (-0.5 + r2 * (1.0 / 24 + r2 * (-1.0 / 720 + r2 * (1.0 / 40320 + r2 * (-1.0 / 3628800))))));
+
+    switch (static_cast<std::int64_t>(quarters) & 3) {
+    case 0: sine = s;  cosine = c;  break;
+    case 1: sine = c;  cosine = -s; break;
+    case 2: sine = -s; cosine = -c; break;
+    default: sine = -c; cosine = s; break;
+    }
+}
@@ -0,0 +1,91 @@
+#include "FrameGovernor.hpp"
+
+unsigned const FrameGovernor::ESCALATE_FRAMES;
+unsigned const FrameGovernor::RESTORE_FRAMES;
+constexpr double FrameGovernor::RESTORE_LOAD;
+constexpr double FrameGovernor::PERCEPTION_STRETCH;
+unsigned const FrameGovernor::WAVE_OCCLUSION_STRIDE;
+unsigned const FrameGovernor::RENDER_STRIDE;
+
+FrameGovernor::FrameGovernor()
+    : budget_(sf::Time::Zero)
+    , level_(FULL_QUALITY)
+    , load_(0)
+    , over_(0)
+    , under_(0)
+    , frame_(0)
+{
+}
+
+void FrameGovernor::setBudget(sf::Time budget)
+{
+    budget_ = budget;
+    if (budget_ <= sf::Time::Zero) {
+        level_ = FULL_QUALITY;
+        load_ = 0;
+        over_ = under_ = 0;
+    }
+}
+
+sf::Time FrameGovernor::getBudget() const
+{
+    return budget_;
+}
+
+void FrameGovernor::record(sf::Time cost)
+{
+    ++frame_;
+    if (budget_ <= sf::Time::Zero) return;
+
+    load_ = cost.asSeconds() / budget_.asSeconds();
+    over_ = load_ > 1 ? over_ + 1 : 0;
+    under_ = load_ < RESTORE_LOAD ? under_ + 1 : 0;
+
+    if (over_ >= ESCALATE_FRAMES and level_ + 1 < LEVEL_COUNT) {
+        level_ = static_cast<Level>(level_ + 1);
+        over_ = 0;
+    } else if (under_ >= RESTORE_FRAMES and level_ > FULL_QUALITY) {
+        level_ = static_cast<Level>(level_ - 1);
+        under_ = 0;
+    }
+}
+
+bool FrameGovernor::canCatchUp(sf::Time spent) const
+{
+    return budget_ <= sf::Time::Zero or spent < budget_;
+}
+
+bool FrameGovernor::isDrawnFrame() const
+{
+    return frame_ % getQuality().render_stride == 0;
+}
+
+FrameGovernor::Level FrameGovernor::getLevel() const
+{
+    return level_;
+}
+
+double FrameGovernor::getLoad() const
+{
+    return load_;
+}
+
+SimulationQuality FrameGovernor::getQuality() const
+{
+    SimulationQuality quality;
+    if (level_ >= WIDE_PERCEPTION)     quality.perception_stretch = PERCEPTION_STRETCH;
+    if (level_ >= COARSE_WAVES)        quality.wave_occlusion_stride = WAVE_OCCLUSION_STRIDE;
+    if (level_ >= DECIMATED_RENDERING) quality.render_stride = RENDER_STRIDE;
+    return quality;
+}
+
+char const* FrameGovernor::levelName(Level level)
+{
+    switch (level) {
+    case FULL_QUALITY:        return "full quality";
+    case WIDE_PERCEPTION:     return "wide perception";
+    case COARSE_WAVES:        return "coarse waves";
+    case DECIMATED_RENDERING: return "decimated rendering";
+    default:                  return "?";
+    }
+}
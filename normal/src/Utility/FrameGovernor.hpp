@@ -0,0 +1,108 @@
+#pragma once
+#include <SFML/System.hpp>
+
+/**
+ * @brief How finely the simulation is run and drawn; the defaults are the
+ *        full quality
+ */
+struct SimulationQuality
+{
+    double perception_stretch = 1;      ///< factor on the perception periods of the animals
+    unsigned wave_occlusion_stride = 1; ///< updates of a wave between two tests of the obstacles it hits
+    unsigned render_stride = 1;         ///< frames between two drawings of the window
+};
+
+/**
+ * @class FrameGovernor
+ * @brief Lowers the quality of the simulation while the frames run over
+ *        their budget, to keep it running in real time
+ *
+ * The cost of every frame, the time spent updating and drawing it, is
+ * compared to the budget. After ESCALATE_FRAMES frames in a row over it,
+ * one more level of degradation is applied, in this order:
+ * - the perception of the animals is staggered over wider periods;
+ * - the waves test the obstacles that shadow them less often;
+ * - the window is only drawn once every few frames.
+ * After RESTORE_FRAMES frames in a row under RESTORE_LOAD times the budget,
+ * the last level applied is lifted again. The gap between the two
+ * thresholds keeps the governor from hopping between two levels.
+ *
+ * A budget of zero disables the governor: the quality stays full.
+ */
+class FrameGovernor
+{
+public:
+    /**
+     * @brief Levels of degradation, each one including the previous ones
+     */
+    enum Level {
+        FULL_QUALITY,
+        WIDE_PERCEPTION,
+        COARSE_WAVES,
+        DECIMATED_RENDERING,
+        LEVEL_COUNT
+    };
+
+    static unsigned const ESCALATE_FRAMES = 10;
+    static unsigned const RESTORE_FRAMES = 60;
+    static constexpr double RESTORE_LOAD = 0.5;
+
+    static constexpr double PERCEPTION_STRETCH = 4;   ///< perception_stretch from WIDE_PERCEPTION on
+    static unsigned const WAVE_OCCLUSION_STRIDE = 8;  ///< wave_occlusion_stride from COARSE_WAVES on
+    static unsigned const RENDER_STRIDE = 3;          ///< render_stride at DECIMATED_RENDERING
+
+    FrameGovernor();
+
+    /**
+     * @brief Sets the budget of a frame; zero disables the governor and
+     *        restores the full quality
+     */
+    void setBudget(sf::Time budget);
+
+    sf::Time getBudget() const;
+
+    /**
+     * @brief Records the cost of a frame and adapts the level to it
+     */
+    void record(sf::Time cost);
+
+    /**
+     * @brief Tells whether a frame that already spent this time updating
+     *        may run one more update to catch up with the real time
+     *
+     * Past the budget the rest of the elapsed time is dropped: the
+     * simulation then runs slower than real time, instead of each frame
+     * having more to catch up than the previous one.
+     */
+    bool canCatchUp(sf::Time spent) const;
+
+    /**
+     * @brief Tells whether the frame being run is to be drawn
+     */
+    bool isDrawnFrame() const;
+
+    Level getLevel() const;
+
+    /**
+     * @brief Cost of the last frame, as a fraction of the budget
+     */
+    double getLoad() const;
+
+    /**
+     * @brief The quality of the current level
+     */
+    SimulationQuality getQuality() const;
+
+    /**
+     * @brief Human readable name of a level
+     */
+    static char const* levelName(Level level);
+
+private:
+    sf::Time budget_;
+    Level level_;
+    double load_;
+    unsigned over_;   ///< frames in a row over the budget
+    unsigned under_;  ///< frames in a row under RESTORE_LOAD times the budget
+    unsigned frame_;  ///< frames recorded, to pick the drawn ones
+};
@@ -0,0 +1,123 @@
+#include "Profiler.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+namespace // anonymous
+{
+
+char const* const PHASE_NAMES[PHASE_COUNT] = {
+    "food generators",
+    "entities",
+    "waves",
+    "deaths",
+    "stats",
+    "draw",
+    "events"
+};
+
+} // anonymous
+
+std::size_t const Profiler::SAMPLES;
+std::size_t const Profiler::EVENTS;
+
+Profiler::Profiler()
+    : origin_(Clock::now())
+    , tick_(0)
+    , events_(EVENTS)
+    , event_count_(0)
+{
+    sample_count_.fill(0);
+}
+
+Profiler& Profiler::forThisThread()
+{
+    static thread_local Profiler profiler;
+    return profiler;
+}
+
+char const* Profiler::phaseName(Phase phase)
+{
+    return PHASE_NAMES[static_cast<std::size_t>(phase)];
+}
+
+void Profiler::beginTick()
+{
+    ++tick_;
+}
+
+std::uint64_t Profiler::getTick() const
+{
+    return tick_;
+}
+
+void Profiler::record(Phase phase, Clock::time_point start, Clock::time_point end)
+{
+    using std::chrono::duration_cast;
+    using std::chrono::nanoseconds;
+
+    std::size_t const p(static_cast<std::size_t>(phase));
+    std::int64_t const duration(duration_cast<nanoseconds>(end - start).count());
+
+    samples_[p][sample_count_[p] % SAMPLES] = duration / 1e6;
+    ++sample_count_[p];
+
+    Event& event(events_[event_count_ % EVENTS]);
+    event.tick = tick_;
+    event.start = duration_cast<nanoseconds>(start - origin_).count();
+    event.duration = duration;
+    event.phase = phase;
+    ++event_count_;
+}
+
+double Profiler::percentile(Phase phase, double fraction) const
+{
+    std::size_t const p(static_cast<std::size_t>(phase));
+    std::size_t const count(std::min(sample_count_[p], SAMPLES));
+    if (count == 0) return 0;
+
+    std::array<double, SAMPLES> sorted(samples_[p]);
+    std::size_t const rank(std::min(count - 1, static_cast<std::size_t>(fraction * count)));
+    std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.begin() + count);
+    return sorted[rank];
+}
+
+std::size_t Profiler::writeTrace(std::string const& path, std::uint64_t firstTick, std::uint64_t lastTick) const
+{
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Couldn't write trace to " + path);
+    }
+
+    // Complete events ("ph":"X"), timestamps in microseconds
+    out << std::fixed << std::setprecision(3);
+    out << "{\"traceEvents\":[";
+    std::size_t written(0);
+    std::size_t const kept(std::min(event_count_, EVENTS));
+    for (std::size_t i(event_count_ - kept); i < event_count_; ++i) {
+        Event const& event(events_[i % EVENTS]);
+        if (event.tick < firstTick or event.tick > lastTick) continue;
+
+        out << (written == 0 ? "\n" : ",\n")
+            << "{\"name\":\"" << phaseName(event.phase) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+            << ",\"ts\":" << event.start / 1e3
+            << ",\"dur\":" << event.duration / 1e3
+            << ",\"args\":{\"tick\":" << event.tick << "}}";
+        ++written;
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return written;
+}
+
+ScopedTimer::ScopedTimer(Phase phase)
+    : profiler_(Profiler::forThisThread())
+    , phase_(phase)
+    , start_(Profiler::Clock::now())
+{
+}
+
+ScopedTimer::~ScopedTimer()
+{
+    profiler_.record(phase_, start_, Profiler::Clock::now());
+}
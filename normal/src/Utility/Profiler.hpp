@@ -0,0 +1,131 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Phases of a simulation tick, as timed by the Profiler
+ */
+enum class Phase : std::uint8_t {
+    FoodGenerators, ///< FoodGenerator::update
+    Entities,       ///< update of every organic entity
+    Waves,          ///< update of every wave
+    Deaths,         ///< death sweep and deletion of the dead
+    Stats,          ///< Stats::update
+    Draw,           ///< rendering of the whole window
+    Events,         ///< SFML event handling
+    Count
+};
+
+std::size_t const PHASE_COUNT = static_cast<std::size_t>(Phase::Count);
+
+/**
+ * @class Profiler
+ * @brief Per-thread timings of the phases of each tick
+ *
+ * Every thread owns its profiler (see forThisThread()), so recording never
+ * takes a lock: the GUI thread profiles the displayed simulation while each
+ * sweep worker silently profiles its own worlds.
+ *
+ * Two things are kept, both in fixed-size rings:
+ * - the last durations of each phase, from which percentiles are computed
+ *   for the control pane;
+ * - the last timed intervals with their tick number, which writeTrace()
+ *   exports as a Chrome trace (chrome://tracing, Perfetto).
+ */
+class Profiler
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    Profiler();
+
+    /**
+     * @brief The profiler of the calling thread
+     */
+    static Profiler& forThisThread();
+
+    /**
+     * @brief Human readable name of a phase
+     */
+    static char const* phaseName(Phase phase);
+
+    /**
+     * @brief Starts a new tick; the following intervals belong to it
+     */
+    void beginTick();
+
+    /**
+     * @brief Number of the current tick
+     */
+    std::uint64_t getTick() const;
+
+    /**
+     * @brief Records one timed interval of a phase
+     */
+    void record(Phase phase, Clock::time_point start, Clock::time_point end);
+
+    /**
+     * @brief Percentile of the recent durations of a phase
+     *
+     * @param phase the phase
+     * @param fraction 0.5 for the median, 0.99 for p99, ...
+     * @return duration in milliseconds, 0 if the phase was never timed
+     */
+    double percentile(Phase phase, double fraction) const;
+
+    /**
+     * @brief Writes the recorded intervals of ticks [firstTick, lastTick]
+     * as a Chrome trace JSON file
+     *
+     * Only intervals still in the ring can be written: the most recent
+     * ones, some thousands of ticks deep.
+     *
+     * @return number of intervals written
+     * @throw std::runtime_error if the file can't be written
+     */
+    std::size_t writeTrace(std::string const& path, std::uint64_t firstTick, std::uint64_t lastTick) const;
+
+private:
+    static std::size_t const SAMPLES = 256;      ///< durations kept per phase
+    static std::size_t const EVENTS = 1 << 15;   ///< intervals kept for the trace
+
+    struct Event
+    {
+        std::uint64_t tick;
+        std::int64_t start;    ///< ns since the profiler's creation
+        std::int64_t duration; ///< ns
+        Phase phase;
+    };
+
+    Clock::time_point origin_;
+    std::uint64_t tick_;
+
+    std::array<std::array<double, SAMPLES>, PHASE_COUNT> samples_; ///< ms
+    std::array<std::size_t, PHASE_COUNT> sample_count_;          ///< total recorded
+
+    std::vector<Event> events_;
+    std::size_t event_count_; ///< total recorded
+};
+
+/**
+ * @class ScopedTimer
+ * @brief Times a phase from construction to destruction
+ */
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(Phase phase);
+    ~ScopedTimer();
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Profiler& profiler_;
+    Phase phase_;
+    Profiler::Clock::time_point start_;
+};
@@ -0,0 +1,132 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @class SmallVector
+ * @brief Vector of trivial values keeping its first N values inline
+ *
+ * Meant for the short lists an entity keeps about its surroundings (what it
+ * saw, its kids), which mostly hold zero to two values: those never
+ * allocate, and longer ones take one heap block rather than one node per
+ * value as a std::list would. The inline values share their storage with
+ * the pointer to the heap block, so with N = 2 pointers the whole vector is
+ * no larger than an empty std::list.
+ *
+ * Only for trivial types (pointers, numbers), which are copied as bytes.
+ *
+ * @tparam T Type of the values
+ * @tparam N Number of values kept inline
+ */
+template <typename T, std::size_t N>
+class SmallVector
+{
+    static_assert(std::is_trivial<T>::value, "SmallVector only holds trivial values");
+    static_assert(N > 0, "SmallVector needs room for one inline value");
+
+public:
+    typedef T value_type;
+    typedef T* iterator;
+    typedef T const* const_iterator;
+
+    SmallVector()
+        : size_(0)
+        , capacity_(N)
+    {
+    }
+
+    SmallVector(SmallVector const& other)
+        : SmallVector()
+    {
+        assign(other.begin(), other.end());
+    }
+
+    SmallVector& operator=(SmallVector const& other)
+    {
+        if (this != &other) {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    ~SmallVector()
+    {
+        if (!isInline()) delete[] heap_;
+    }
+
+    iterator begin()             { return data(); }
+    iterator end()               { return data() + size_; }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const   { return data() + size_; }
+
+    std::size_t size() const { return size_; }
+    bool empty() const       { return size_ == 0; }
+
+    T& front()             { return data()[0]; }
+    T const& front() const { return data()[0]; }
+    T& operator[](std::size_t i)             { return data()[i]; }
+    T const& operator[](std::size_t i) const { return data()[i]; }
+
+    void push_back(T const& value)
+    {
+        if (size_ == capacity_) grow(2 * capacity_);
+        data()[size_++] = value;
+    }
+
+    /**
+     * @brief Empties the vector, keeping its capacity
+     */
+    void clear()
+    {
+        size_ = 0;
+    }
+
+    /**
+     * @brief Removes every value equal to value, keeping the order of the
+     *        others, as std::list::remove
+     */
+    void remove(T const& value)
+    {
+        size_ = static_cast<std::uint32_t>(std::remove(begin(), end(), value) - begin());
+    }
+
+    /**
+     * @brief Bytes allocated on the heap, 0 while the values fit inline
+     */
+    std::size_t heapBytes() const
+    {
+        return isInline() ? 0 : capacity_ * sizeof(T);
+    }
+
+private:
+    bool isInline() const { return capacity_ <= N; }
+    T* data()             { return isInline() ? inline_ : heap_; }
+    T const* data() const { return isInline() ? inline_ : heap_; }
+
+    void assign(const_iterator first, const_iterator last)
+    {
+        std::size_t const count(last - first);
+        if (count > capacity_) grow(count);
+        std::memmove(data(), first, count * sizeof(T));
+        size_ = static_cast<std::uint32_t>(count);
+    }
+
+    void grow(std::size_t capacity)
+    {
+        T* const values(new T[capacity]);
+        std::memcpy(values, data(), size_ * sizeof(T));
+        if (!isInline()) delete[] heap_;
+        heap_ = values;
+        capacity_ = static_cast<std::uint32_t>(capacity);
+    }
+
+    std::uint32_t size_;
+    std::uint32_t capacity_; ///< N while the values are inline
+    union {
+        T* heap_;
+        T inline_[N];
+    };
+};
@@ -0,0 +1,91 @@
+#pragma once
+#include "Vec2d.hpp"
+
+#include <cstdint>
+
+/**
+ * @class TorusPoint
+ * @brief Position on the toric world in 32 bit fixed point
+ *
+ * Each coordinate maps [0, worldSize) onto the whole range of a
+ * std::uint32_t, so that the arithmetic of unsigned integers is the
+ * arithmetic of the torus: moving past a border wraps around by overflow,
+ * and the difference of two coordinates cast to a signed integer is the
+ * shortest way from one to the other (the minimum image), without
+ * comparisons nor the nine periodic images of the double version.
+ *
+ * A step is worldSize / 2^32, e.g. 2.3e-7 for a world of 1000. Integer
+ * positions are the same on every compiler and thread, whatever the
+ * rounding of the computations in between.
+ */
+class TorusPoint
+{
+public:
+    TorusPoint()
+        : x(0)
+        , y(0)
+    {
+    }
+
+    /**
+     * @brief Position of a point given in world coordinates, wrapped
+     *        around the torus however far out it is
+     */
+    TorusPoint(Vec2d const& position, double worldSize)
+        : x(toSteps(position.x, stepsPerUnit(worldSize)))
+        , y(toSteps(position.y, stepsPerUnit(worldSize)))
+    {
+    }
+
+    /**
+     * @brief The position in world coordinates, in [0, worldSize)
+     */
+    Vec2d toVec2d(double worldSize) const
+    {
+        double const step(worldSize / STEPS);
+        return { x * step, y * step };
+    }
+
+    /**
+     * @brief Shortest vector to a target around the torus
+     */
+    Vec2d to(TorusPoint const& target, double worldSize) const
+    {
+        double const step(worldSize / STEPS);
+        return { static_cast<std::int32_t>(target.x - x) * step,
+                 static_cast<std::int32_t>(target.y - y) * step };
+    }
+
+    /**
+     * @brief Moves by a displacement given in world coordinates
+     */
+    void move(Vec2d const& displacement, double worldSize)
+    {
+        double const perUnit(stepsPerUnit(worldSize));
+        x += toSteps(displacement.x, perUnit);
+        y += toSteps(displacement.y, perUnit);
+    }
+
+    bool operator==(TorusPoint const& other) const
+    {
+        return x == other.x and y == other.y;
+    }
+
+    std::uint32_t x, y; ///< steps of worldSize / 2^32 from the origin
+
+private:
+    static constexpr double STEPS = 4294967296.0; ///< 2^32 steps per side
+
+    static double stepsPerUnit(double worldSize)
+    {
+        return STEPS / worldSize;
+    }
+
+    /// Nearest step of a coordinate, modulo 2^32 (rounded as std::llround,
+    /// without its library call)
+    static std::uint32_t toSteps(double coordinate, double perUnit)
+    {
+        double const steps(coordinate * perUnit);
+        return static_cast<std::uint32_t>(static_cast<std::int64_t>(steps + (steps < 0 ? -0.5 : 0.5)));
+    }
+};
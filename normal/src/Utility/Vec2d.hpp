@@ -9,6 +9,11 @@
 
 #include <SFML/System.hpp>
 #include <Utility/Constants.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <iosfwd>
+#include <type_traits>
 /*!
  * @class Vec2d
  *
@@ -16,43 +21,80 @@
  *
  * It can be implicitely constructed from a sf::Vector2i or sf::Vector2f
  * and can be converted implictely to those same types.
+ *
+ * It is a trivially copyable value type defined in this header, with
+ * constexpr constructors and arithmetic, so that every translation unit
+ * can inline its operations and keep vectors in registers. Only the
+ * functions calling libm are defined in Vec2d.cpp.
+ *
+ * When built with INFOSV_FAST_MATH, normalised(), angle() and fromAngle()
+ * use the approximations of Utility/FastMath.hpp instead of
+ * the libm calls.
  */
 class Vec2d
 {
 public:
-    Vec2d();
-    Vec2d(double x, double y);
+    constexpr Vec2d()
+        : x(0.0)
+        , y(0.0)
+    {
+    }
+
+    constexpr Vec2d(double x_, double y_)
+        : x(x_)
+        , y(y_)
+    {
+    }
 
-    Vec2d(sf::Vector2f const& sfvect);
-    Vec2d(sf::Vector2i const& sfvect);
+    Vec2d(sf::Vector2f const& sfvect)
+        : x(sfvect.x)
+        , y(sfvect.y)
+    {
+    }
 
-    Vec2d(Vec2d const& other);
+    Vec2d(sf::Vector2i const& sfvect)
+        : x(sfvect.x)
+        , y(sfvect.y)
+    {
+    }
 
-    // We don't need :
+    // The copy constructor and assignment are the implicit ones, so that
+    // Vec2d stays trivially copyable. We don't need either :
     //    Vec2d& operator=(sf::Vector2f const& sfvect);
     //    Vec2d& operator=(sf::Vector2i const& sfvect);
     // Because C++ will automatically construct a Vec2d
-    // with the appropriate constructor and the following
-    // assignement operator will be called :
+    // with the appropriate constructor and the implicit
+    // assignement operator will be called.
 
-    Vec2d& operator=(Vec2d const& other);
+    operator sf::Vector2f() const
+    {
+        return { float(x), float(y) };
+    }
 
-    operator sf::Vector2f() const;
-    operator sf::Vector2i() const; // TOOD is it a good idea to lose the precision ?
+    operator sf::Vector2i() const // TOOD is it a good idea to lose the precision ?
+    {
+        return { int(x), int(y) };
+    }
 
     /*!
      * @brief Compute the length of the vector (squarred)
      *
      * @return the square module of this
      */
-    double lengthSquared() const;
+    constexpr double lengthSquared() const
+    {
+        return x * x + y * y;
+    }
 
     /*!
      * @brief Compute the length of te vector
      *
      * @return the module of this
      */
-    double length() const;
+    double length() const
+    {
+        return std::sqrt(lengthSquared());
+    }
 
     /*!
      * @brief Compute the normilsed vector
@@ -66,7 +108,10 @@ public:
      *
      * @return n such that this · n = 0
      */
-    Vec2d normal() const;
+    constexpr Vec2d normal() const
+    {
+        return { y, -x };
+    }
 
     /*!
      * @brief Compute the angle of this in polar coordinates
@@ -75,13 +120,35 @@ public:
      */
     double angle() const;
 
+    /*!
+     * @brief Compute the unit vector of a given angle
+     *
+     * @param angle angle in radians
+     * @return (cos angle, sin angle)
+     */
+    static Vec2d fromAngle(double angle);
+
+    /*!
+     * @brief Compare the length of the vector without computing it
+     *
+     * @param length a non negative length
+     * @return true if |this| > length
+     */
+    constexpr bool isLongerThan(double length) const
+    {
+        return lengthSquared() > length * length;
+    }
+
     /*!
      * @brief Compute the dot product
      *
      * @param other another vector
      * @return the inner product
      */
-    double dot(Vec2d const& other) const;
+    constexpr double dot(Vec2d const& other) const
+    {
+        return x * other.x + y * other.y;
+    }
 
     /*!
      * @brief Compare two vectors' angle
@@ -91,19 +158,69 @@ public:
      */
     int sign(Vec2d const& other) const;
 
-    Vec2d operator-() const; ///< Negation
-    Vec2d operator-(Vec2d const& b) const;
-    Vec2d operator+(Vec2d const& b) const;
-    Vec2d operator*(double c) const;
-    Vec2d operator/(double c) const;
+    constexpr Vec2d operator-() const ///< Negation
+    {
+        return { -x, -y };
+    }
+
+    constexpr Vec2d operator-(Vec2d const& b) const
+    {
+        return { x - b.x, y - b.y };
+    }
+
+    constexpr Vec2d operator+(Vec2d const& b) const
+    {
+        return { x + b.x, y + b.y };
+    }
+
+    constexpr Vec2d operator*(double c) const
+    {
+        return { x * c, y * c };
+    }
+
+    /// Multiplies by 1 / c, like every division of Vec2d
+    constexpr Vec2d operator/(double c) const
+    {
+        return *this * (1.0 / c);
+    }
 
-    Vec2d& operator-=(Vec2d const& b);
-    Vec2d& operator+=(Vec2d const& b);
-    Vec2d& operator*=(double c);
-    Vec2d& operator/=(double c);
+    Vec2d& operator-=(Vec2d const& b)
+    {
+        x -= b.x;
+        y -= b.y;
+        return *this;
+    }
 
-    bool operator==(Vec2d const& b) const;
-    bool operator!=(Vec2d const& b) const;
+    Vec2d& operator+=(Vec2d const& b)
+    {
+        x += b.x;
+        y += b.y;
+        return *this;
+    }
+
+    Vec2d& operator*=(double c)
+    {
+        x *= c;
+        y *= c;
+        return *this;
+    }
+
+    Vec2d& operator/=(double c)
+    {
+        return *this *= (1.0 / c);
+    }
+
+    /// Equality up to EPSILON on each coordinate, as isEqual()
+    constexpr bool operator==(Vec2d const& b) const
+    {
+        return (x - b.x < EPSILON and b.x - x < EPSILON)
+               and (y - b.y < EPSILON and b.y - y < EPSILON);
+    }
+
+    constexpr bool operator!=(Vec2d const& b) const
+    {
+        return !(*this == b);
+    }
 
     /*!
      * @brief Index access, read-write
@@ -111,7 +228,11 @@ public:
      * @param axis only value 0 and 1 are allowed
      * @return x if axis is 0, y if axis if 1, undefined otherwise
      */
-    double& operator[](int axis);
+    double& operator[](int axis)
+    {
+        assert(axis == 0 or axis == 1);
+        return axis == 0 ? x : y;
+    }
 
     /*!
      * @brief Index access, read-only
@@ -119,14 +240,23 @@ public:
      * @param axis only value 0 and 1 are allowed
      * @return x if axis is 0, y if axis if 1, undefined otherwise
      */
-    double operator[](int axis) const;
+    double operator[](int axis) const
+    {
+        assert(axis == 0 or axis == 1);
+        return axis == 0 ? x : y;
+    }
 
 public:
     double x, y; ///< DATA
 };
 
+static_assert(std::is_trivially_copyable<Vec2d>::value, "Vec2d must stay a plain value type");
 
-Vec2d operator*(double c, Vec2d const& a);
+
+constexpr Vec2d operator*(double c, Vec2d const& a)
+{
+    return a * c;
+}
 
 
 /*!
@@ -136,7 +266,23 @@ Vec2d operator*(double c, Vec2d const& a);
  * @param y another point
  * @param the distance between x and y
  */
-double distance(Vec2d const& x, Vec2d const& y);
+inline double distance(Vec2d const& x, Vec2d const& y)
+{
+    return (x - y).length();
+}
+
+/*!
+ * @brief Compute the squared distance between two given points, to compare
+ *        distances without square roots
+ *
+ * @param x a point
+ * @param y another point
+ * @param the squared distance between x and y
+ */
+constexpr double distanceSquared(Vec2d const& x, Vec2d const& y)
+{
+    return (x - y).lengthSquared();
+}
 
 /*!
  * @brief Compute the normal vector of a segment
@@ -145,7 +291,10 @@ double distance(Vec2d const& x, Vec2d const& y);
  * @param b end of the segment
  * @return normal vector of [a, b]
  */
-Vec2d normal(Vec2d const& a, Vec2d const& b);
+constexpr Vec2d normal(Vec2d const& a, Vec2d const& b)
+{
+    return (a - b).normal();
+}
 
 std::ostream& operator<<(std::ostream& out, Vec2d const& v);
 